@@ -0,0 +1,91 @@
+/*
+  ButtonSizes.ino - A program to print the RAM taken by an object of each
+  button class, to help size a screen with many buttons.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+
+  Usage:
+
+  Compile, load, and run, and view the results on the serial monitor. No
+  display is needed. For each button class, the size of an object and the
+  largest size allowed by its header file (checked with static_assert() when
+  the library is compiled) are printed, followed by the RAM taken by a screen
+  of SCREEN_BUTTONS label buttons.
+
+  The sizes depend on the processor's pointer size and on the settings in
+  Button_TT.h: BUTTON_TT_DBG adds the button name, BUTTON_TT_SHARED_GFX
+  removes the display object pointer, BUTTON_TT_DIRTY_RECTS and
+  BUTTON_TT_BACKGROUND each add a pointer, and BUTTON_TT_PALETTE makes the
+  colors one byte each. In Button_TT_label.h, BUTTON_TT_LABEL_CACHE adds a
+  pointer to the label buttons and BUTTON_TT_BODY_REDRAW adds 8 bytes.
+*/
+#include <Arduino.h>
+#include <Button_TT_label.h>
+#include <Button_TT_arrow.h>
+#include <Button_TT_int8.h>
+#include <Button_TT_uint8.h>
+#include <Button_TT_int16.h>
+#include <Button_TT_uint16.h>
+#include <monitor_printf.h>
+
+// Number of label buttons on the example screen.
+#define SCREEN_BUTTONS  60
+
+// Print the size and the size limit of a class.
+void printSize(const char* name, size_t size, size_t limit) {
+  monitor.printf("  %-16s %3u bytes (limit %u)\n", name, (unsigned)size,
+    (unsigned)limit);
+}
+
+// Standard Arduino setup() function.
+void setup() {
+  // Initialize for printfs to serial monitor.
+  monitor.begin(&Serial, 115200);
+  monitor.printf("Initializing\n");
+
+  monitor.printf("Button object sizes, %u-byte pointers:\n",
+    (unsigned)sizeof(void*));
+  printSize("Button_TT", sizeof(Button_TT), BUTTON_TT_SIZE);
+  printSize("Button_TT_label", sizeof(Button_TT_label), BUTTON_TT_LABEL_SIZE);
+  printSize("Button_TT_arrow", sizeof(Button_TT_arrow), BUTTON_TT_ARROW_SIZE);
+  printSize("Button_TT_int8", sizeof(Button_TT_int8), BUTTON_TT_INT8_SIZE);
+  printSize("Button_TT_uint8", sizeof(Button_TT_uint8), BUTTON_TT_UINT8_SIZE);
+  printSize("Button_TT_int16", sizeof(Button_TT_int16), BUTTON_TT_INT16_SIZE);
+  printSize("Button_TT_uint16", sizeof(Button_TT_uint16),
+    BUTTON_TT_UINT16_SIZE);
+  monitor.printf("%d label buttons: %u bytes, plus their label text\n",
+    SCREEN_BUTTONS, (unsigned)(SCREEN_BUTTONS * sizeof(Button_TT_label)));
+}
+
+// Standard Arduino loop() function.
+void loop() {
+}
@@ -0,0 +1,100 @@
+/*
+  ExpandBenchmark.ino - A program to measure the speed of expanding rows of
+  1-bit pixels (glyph and icon masks) into RGB565 pixels, comparing
+  TextRender_TT::expandBits() with a simple loop over the bits.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Usage:
+
+  Compile, load, and run, and view the results on the serial monitor. No
+  display is needed. Each test expands ROWS rows of ROW_WIDTH pixels and prints
+  the time taken in microseconds, and checks that both methods give the same
+  pixels.
+
+  expandBits() uses SSE2/AVX2 or NEON vector instructions when the processor
+  and compiler options provide them (e.g. when building for a desktop
+  simulator), and otherwise a table of pixel pairs.
+*/
+#include <Arduino.h>
+#include <TextRender_TT.h>
+#include <monitor_printf.h>
+
+// Width in pixels of each row expanded, and number of rows to expand.
+#define ROW_WIDTH   240
+#define ROWS        1000
+
+// The 1-bit pixels to expand, and the resulting pixels of each method.
+static uint8_t bits[ROW_WIDTH / 8];
+static uint16_t pixelsKernel[ROW_WIDTH];
+static uint16_t pixelsLoop[ROW_WIDTH];
+
+// Expand one row one bit at a time, the way it is done without the kernel.
+void expandLoop(const uint8_t* bits, uint16_t* pixels, int16_t w,
+    uint16_t color, uint16_t bg) {
+  for (int16_t i = 0; i < w; i++)
+    pixels[i] = (bits[i >> 3] & (0x80 >> (i & 7))) ? color : bg;
+}
+
+// Standard Arduino setup() function.
+void setup() {
+  // Initialize for printfs to serial monitor.
+  monitor.begin(&Serial, 115200);
+  monitor.printf("Initializing\n");
+
+  // Use a repeatable pattern of bits.
+  randomSeed(1);
+  for (uint16_t i = 0; i < sizeof(bits); i++)
+    bits[i] = random(256);
+
+  // Time the kernel. The color changes with each row so that no work can be
+  // skipped.
+  uint32_t start = micros();
+  for (uint16_t row = 0; row < ROWS; row++)
+    TextRender_TT::expandBits(bits, pixelsKernel, ROW_WIDTH, row, 0xFFFF);
+  uint32_t usKernel = micros() - start;
+
+  // Time the loop.
+  start = micros();
+  for (uint16_t row = 0; row < ROWS; row++)
+    expandLoop(bits, pixelsLoop, ROW_WIDTH, row, 0xFFFF);
+  uint32_t usLoop = micros() - start;
+
+  bool same = memcmp(pixelsKernel, pixelsLoop, sizeof(pixelsKernel)) == 0;
+  monitor.printf("%d rows of %d pixels:\n", ROWS, ROW_WIDTH);
+  monitor.printf("  expandBits(): %lu us\n", (unsigned long)usKernel);
+  monitor.printf("  bit loop:     %lu us\n", (unsigned long)usLoop);
+  monitor.printf("  results %s\n", same ? "match" : "DIFFER");
+}
+
+// Standard Arduino loop() function.
+void loop() {
+}
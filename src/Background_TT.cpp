@@ -0,0 +1,83 @@
+/*
+  Background_TT.cpp - Defines functions of class RLEBackground_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <Background_TT.h>
+#include <Clip_TT.h>
+#include <pgmspace_GFX.h>
+
+/**************************************************************************/
+void RLEBackground_TT::draw(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    uint16_t w, uint16_t h) {
+
+  int32_t xR = (int32_t)x + w, yB = (int32_t)y + h;
+  int32_t imageR = (int32_t)_x + _w;
+  gfx->startWrite();
+  for (int32_t yy = y; yy < yB; yy++) {
+    int32_t row = yy - _y;
+    if (row < 0 || row >= _h) {
+      Clip_TT::writeFastHLine(gfx, x, yy, w, _color);
+      continue;
+    }
+
+    // Draw the parts of the row left and right of the image, leaving xa to
+    // xb to be drawn from the image.
+    int32_t xa = x, xb = xR;
+    if (xa < _x) {
+      int32_t e = (xb < _x) ? xb : _x;
+      Clip_TT::writeFastHLine(gfx, xa, yy, e - xa, _color);
+      xa = _x;
+    }
+    if (xb > imageR) {
+      int32_t e = (xa > imageR) ? xa : imageR;
+      Clip_TT::writeFastHLine(gfx, e, yy, xb - e, _color);
+      xb = imageR;
+    }
+    if (xa >= xb || Clip_TT::rejects(xa, yy, xb - xa, 1))
+      continue;
+
+    // Walk the row's runs, drawing the part of each one in xa to xb.
+    const uint16_t* p = _runs + 2 * (uint32_t)pgm_read_dword(&_rows[row]);
+    for (int32_t px = _x; px < xb; ) {
+      uint16_t n = pgm_read_word(p++);
+      uint16_t color = pgm_read_word(p++);
+      int32_t a = (px > xa) ? px : xa;
+      int32_t b = (px + n < xb) ? px + n : xb;
+      if (a < b)
+        Clip_TT::writeFastHLine(gfx, a, yy, b - a, color);
+      px += n;
+    }
+  }
+  gfx->endWrite();
+}
+
+// -------------------------------------------------------------------------
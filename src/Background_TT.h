@@ -0,0 +1,162 @@
+/*
+  Background_TT.h - Defines C++ class Background_TT, the interface for drawing
+  the background of a screen behind its buttons, and class RLEBackground_TT,
+  which draws a run-length encoded image.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  A button whose fill color is TRANSPARENT_COLOR is drawn over whatever lies
+  behind it, such as a background image. Nothing erases what it drew before,
+  so when its label changes, the old label's pixels are left behind, and when
+  it is drawn with an opaque fill (e.g. inverted, while pressed) and then
+  transparent again, the fill is left behind.
+
+  A Background_TT object draws any rectangle of the screen's background. Give
+  it to a button with Button_TT::setBackground(), and the button then restores
+  the background itself before it is drawn with a transparent fill: the whole
+  button if its last drawing covered it (with a fill, or with an outline that
+  is now transparent), else just the rectangle of the label it last drew,
+  inside its outline. The rest of the screen is not redrawn. Buttons have a
+  background only if BUTTON_TT_BACKGROUND is set to 1 in Button_TT.h.
+
+  Derive a class from Background_TT to draw a procedural background (a color
+  gradient, a grid, etc.). Class RLEBackground_TT draws an RGB565 image that
+  is run-length encoded, row by row, usually kept in PROGMEM: each row is a
+  series of runs of equal pixels, each run being a pair of 16-bit words, the
+  number of pixels and their color, and a table gives the index of each row's
+  first run, so any rectangle can be drawn without decoding the rows above it.
+  Each run is drawn as one horizontal line. The image is placed at a given
+  position on the screen, and the screen outside it is a fill color.
+
+  The background is drawn through Clip_TT, so it is limited to any clip
+  rectangle, and on the button's display object, so it is drawn into the
+  strip buffer of StripRender_TT when the button is drawn there.
+
+  Example:
+
+    // Runs and row table of a 320 x 240 image, from an image converter.
+    extern const uint16_t sky_runs[] PROGMEM;
+    extern const uint32_t sky_rows[] PROGMEM;
+    RLEBackground_TT sky(sky_runs, sky_rows, 320, 240);
+    ...
+    btn_Temperature.setBackground(&sky);
+*/
+#ifndef Background_TT_h
+#define Background_TT_h
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+/**************************************************************************/
+/*!
+  @brief  Interface for drawing the background of a screen.
+*/
+/**************************************************************************/
+class Background_TT {
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Destructor.
+  */
+  /**************************************************************************/
+  virtual ~Background_TT() {}
+
+  /**************************************************************************/
+  /*!
+    @brief    Draw a rectangle of the background.
+    @param    gfx     The display object to draw on.
+    @param    x       Left edge of the rectangle.
+    @param    y       Top edge of the rectangle.
+    @param    w       Width of the rectangle.
+    @param    h       Height of the rectangle.
+  */
+  /**************************************************************************/
+  virtual void draw(Adafruit_GFX* gfx, int16_t x, int16_t y, uint16_t w,
+    uint16_t h) = 0;
+};
+
+/**************************************************************************/
+/*!
+  @brief  A Background_TT that draws a run-length encoded RGB565 image.
+*/
+/**************************************************************************/
+class RLEBackground_TT : public Background_TT {
+
+protected:
+
+  const uint16_t* _runs;      // Pixel count and color of each run, in PROGMEM.
+  const uint32_t* _rows;      // Index of each row's first run, in PROGMEM.
+  uint16_t _w, _h;            // Image size.
+  int16_t _x, _y;             // Screen position of the image's top left.
+  uint16_t _color;            // Color of the screen outside the image.
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    runs    The image's runs, in PROGMEM: a pixel count and a color
+                      for each run, row by row, the counts of each row adding
+                      up to w.
+    @param    rows    Index in 'runs' of the first run of each row, counting
+                      runs (pairs of words), in PROGMEM. h entries.
+    @param    w       Image width.
+    @param    h       Image height.
+    @param    x       Screen x-coordinate of the image's left edge.
+    @param    y       Screen y-coordinate of the image's top edge.
+    @param    color   Color of the screen outside the image.
+  */
+  /**************************************************************************/
+  RLEBackground_TT(const uint16_t* runs, const uint32_t* rows, uint16_t w,
+      uint16_t h, int16_t x = 0, int16_t y = 0, uint16_t color = 0) {
+    _runs = runs;
+    _rows = rows;
+    _w = w;
+    _h = h;
+    _x = x;
+    _y = y;
+    _color = color;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Draw a rectangle of the image, see Background_TT::draw().
+  */
+  /**************************************************************************/
+  void draw(Adafruit_GFX* gfx, int16_t x, int16_t y, uint16_t w,
+    uint16_t h) override;
+};
+
+#endif // Background_TT_h
@@ -0,0 +1,331 @@
+/*
+  ButtonSet_TT.h - Defines C++ class template ButtonSet_TT, a collection of
+  buttons whose classes are known at compile time, which hit-tests and draws
+  them without virtual function calls.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  Class Button_TT_collection holds pointers to Button_TT objects, so each
+  button it draws is drawn through a virtual function call, an indirect call
+  that the compiler can't inline, and its hit test (contains()) is a call for
+  each button.
+
+  When the buttons of a screen are known when the program is compiled, a
+  ButtonSet_TT object can be used instead. Its template arguments are the
+  classes of the buttons, in the order in which they are tested and drawn,
+  and its constructor arguments are the buttons, each followed by the function
+  to call when it is pressed, which takes a reference to the button's own
+  class (or nullptr for none). The set holds a reference to each button with
+  its class, and calls its drawButton() function by its class name, so the
+  compiler calls it directly and can inline it. Its loops over the buttons
+  are unrolled at compile time, and contains() is inlined in them.
+
+  The buttons are still Button_TT objects with virtual functions, so they can
+  also be used with Button_TT_collection, DirtyRects_TT and StripRender_TT.
+  The class given for each button must be the button's own class, not a base
+  class of it, else the base class's drawButton() is called.
+
+  Example:
+
+    void onTemperature(Button_TT_label& btn);
+    void onUp(Button_TT_arrow& btn);
+    ...
+    ButtonSet_TT<Button_TT_label, Button_TT_arrow> mainScreen(
+      btn_Temperature, onTemperature, btn_Up, onUp);
+    ...
+    mainScreen.drawIfChanged(true);
+    ...
+    if (touched)
+      mainScreen.press(x, y);
+    else
+      mainScreen.release();
+*/
+#ifndef ButtonSet_TT_h
+#define ButtonSet_TT_h
+
+#include <Arduino.h>
+#include <Button_TT.h>
+
+/**************************************************************************/
+/*!
+  @brief  A list of buttons of the given classes: the first button, the
+          function to call when it is pressed, and the list of the rest. Used
+          by ButtonSet_TT. The list with no buttons ends the recursion.
+*/
+/**************************************************************************/
+template <class... Buttons>
+class ButtonSetNode_TT;
+
+template <>
+class ButtonSetNode_TT<> {
+
+public:
+
+  ButtonSetNode_TT() {}
+
+  int8_t find(int16_t x, int16_t y, int8_t i) {
+    (void)x;
+    (void)y;
+    (void)i;
+    return (-1);
+  }
+
+  int8_t press(int16_t x, int16_t y, int8_t i,
+      void (*masterPressRelease)(bool press)) {
+    (void)x;
+    (void)y;
+    (void)i;
+    (void)masterPressRelease;
+    return (-1);
+  }
+
+  void release(int8_t i) { (void)i; }
+
+  uint8_t drawIfChanged(bool forceDraw) {
+    (void)forceDraw;
+    return (0);
+  }
+};
+
+template <class B, class... Rest>
+class ButtonSetNode_TT<B, Rest...> {
+
+protected:
+
+  B& _button;
+  void (*_processPress)(B& button);
+  ButtonSetNode_TT<Rest...> _rest;
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    button        The first button.
+    @param    processPress  The function to call when it is pressed, nullptr if
+                            none.
+    @param    args          The rest of the buttons and their functions.
+  */
+  /**************************************************************************/
+  template <class... Args>
+  ButtonSetNode_TT(B& button, void (*processPress)(B& button),
+      Args&&... args) : _button(button), _processPress(processPress),
+      _rest(args...) {}
+
+  /**************************************************************************/
+  /*!
+    @brief    Return i plus the index in the list of the first button
+              containing (x,y), -1 if none.
+  */
+  /**************************************************************************/
+  int8_t find(int16_t x, int16_t y, int8_t i) {
+    if (_button.contains(x, y))
+      return (i);
+    return (_rest.find(x, y, i + 1));
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Press the first button of the list containing (x,y) if it isn't
+              pressed, calling masterPressRelease(true) if not nullptr, then
+              drawing it and calling its function. Return i plus its index in
+              the list, or -1 if no button contains (x,y) or it is already
+              pressed.
+  */
+  /**************************************************************************/
+  int8_t press(int16_t x, int16_t y, int8_t i,
+      void (*masterPressRelease)(bool press)) {
+    if (!_button.contains(x, y))
+      return (_rest.press(x, y, i + 1, masterPressRelease));
+    if (_button.isPressed())
+      return (-1);
+    if (masterPressRelease != nullptr)
+      masterPressRelease(true);
+    if (_button.setPressed(true))
+      _button.B::drawButton(true);
+    if (_processPress != nullptr)
+      (*_processPress)(_button);
+    return (i);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Release the button with index i in the list and draw it.
+  */
+  /**************************************************************************/
+  void release(int8_t i) {
+    if (i > 0)
+      _rest.release(i - 1);
+    else if (_button.setPressed(false))
+      _button.B::drawButton(false);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Redraw each button of the list that has changed since it was last
+              drawn, see ButtonSet_TT::drawIfChanged().
+  */
+  /**************************************************************************/
+  uint8_t drawIfChanged(bool forceDraw) {
+    uint8_t n = 0;
+    if (_button.hasChanged() || forceDraw) {
+      _button.B::drawButton(_button.getInverted());
+      n++;
+    }
+    return (n + _rest.drawIfChanged(forceDraw));
+  }
+};
+
+/**************************************************************************/
+/*!
+  @brief  A class that holds a collection of buttons of the classes given as
+          template arguments, which hit-tests and draws them with no virtual
+          function calls.
+*/
+/**************************************************************************/
+template <class... Buttons>
+class ButtonSet_TT {
+
+  static_assert(sizeof...(Buttons) <= 127, "too many buttons in ButtonSet_TT");
+
+protected:
+
+  // The buttons and their press processing functions.
+  ButtonSetNode_TT<Buttons...> _buttons;
+
+  // Index of the pressed button, -1 if none. Only one button at a time can be
+  // pressed.
+  int8_t _pressedButton;
+
+  // Master button press/release function to call on press or release.
+  void (*_masterPressRelease)(bool press);
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    args      The buttons, in the order of the template arguments,
+                        each followed by the function to call when it is
+                        pressed, with its single argument being a reference to
+                        the button, or nullptr for none.
+  */
+  /**************************************************************************/
+  template <class... Args>
+  ButtonSet_TT(Args&&... args) : _buttons(args...) {
+    _pressedButton = -1;
+    _masterPressRelease = nullptr;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of buttons.
+    @returns  The number of buttons in the set.
+  */
+  /**************************************************************************/
+  uint8_t size(void) { return (sizeof...(Buttons)); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Register a master button press/release processing function, see
+              Button_TT_collection::registerMasterProcessFunc().
+    @param    masterPressReleaseFunc  Function to call at each press or release
+                                      of a button, nullptr for none.
+  */
+  /**************************************************************************/
+  void registerMasterProcessFunc(void (*masterPressReleaseFunc)(bool press)) {
+    _masterPressRelease = masterPressReleaseFunc;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Find the first button containing the point (x,y).
+    @param    x             The X coordinate to check.
+    @param    y             The Y coordinate to check.
+    @returns  Index of the button, in the order of the template arguments, -1
+              if no button contains (x,y).
+  */
+  /**************************************************************************/
+  int8_t find(int16_t x, int16_t y) { return (_buttons.find(x, y, 0)); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Search the buttons for one containing the point (x,y), and if
+              found and not already pressed, call masterPressRelease() if not
+              nullptr, press it and draw it inverted, and then call its press
+              processing function.
+    @param    x             The X coordinate to check.
+    @param    y             The Y coordinate to check.
+    @returns  false if no button contains (x,y) or it is already pressed,
+              else true.
+  */
+  /**************************************************************************/
+  bool press(int16_t x, int16_t y) {
+    int8_t i = _buttons.press(x, y, 0, _masterPressRelease);
+    if (i < 0)
+      return (false);
+    _pressedButton = i;
+    return (true);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Call masterPressRelease() if not nullptr, then release the last
+              button pressed, if any, and draw it.
+    @returns  false if no button was previously pressed, else true.
+  */
+  /**************************************************************************/
+  bool release(void) {
+    if (_masterPressRelease != nullptr)
+      _masterPressRelease(false);
+    if (_pressedButton < 0)
+      return (false);
+    _buttons.release(_pressedButton);
+    _pressedButton = -1;
+    return (true);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Redraw each button that has changed since it was last drawn (see
+              Button_TT::drawIfChanged()), or all buttons.
+    @param    forceDraw     If true, all buttons are drawn.
+    @returns  The number of buttons drawn.
+  */
+  /**************************************************************************/
+  uint8_t drawIfChanged(bool forceDraw = false) {
+    return (_buttons.drawIfChanged(forceDraw));
+  }
+};
+
+#endif // ButtonSet_TT_h
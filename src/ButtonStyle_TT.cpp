@@ -0,0 +1,133 @@
+/*
+  ButtonStyle_TT.cpp - Defines functions of class ButtonStyle_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <ButtonStyle_TT.h>
+
+/**************************************************************************/
+void ButtonStyle_TT::applyToButtons(void) {
+
+  for (uint8_t i = 0; i < _numButtons; i++)
+    _buttons[i]->applyStyle(*this);
+}
+
+/**************************************************************************/
+bool ButtonStyle_TT::addButton(Button_TT& button) {
+
+  for (uint8_t i = 0; i < _numButtons; i++)
+    if (_buttons[i] == &button)
+      return (true);
+  if (_numButtons == BUTTON_STYLE_TT_MAX_BUTTONS)
+    return (false);
+  _buttons[_numButtons++] = &button;
+  button.applyStyle(*this);
+  return (true);
+}
+
+/**************************************************************************/
+bool ButtonStyle_TT::removeButton(Button_TT& button) {
+
+  for (uint8_t i = 0; i < _numButtons; i++) {
+    if (_buttons[i] == &button) {
+      _numButtons--;
+      for (; i < _numButtons; i++)
+        _buttons[i] = _buttons[i + 1];
+      return (true);
+    }
+  }
+  return (false);
+}
+
+/**************************************************************************/
+bool ButtonStyle_TT::setColors(uint16_t outlineColor, uint16_t fillColor,
+    uint16_t textColor) {
+
+  if (_outlineColor != outlineColor || _fillColor != fillColor ||
+      _textColor != textColor) {
+    _outlineColor = outlineColor;
+    _fillColor = fillColor;
+    _textColor = textColor;
+    applyToButtons();
+    return (true);
+  }
+  return (false);
+}
+
+/**************************************************************************/
+bool ButtonStyle_TT::setTextAlign(const char* textAlign) {
+
+  if (strcmp(_textAlign, textAlign) != 0) {
+    _textAlign = textAlign;
+    applyToButtons();
+    return (true);
+  }
+  return (false);
+}
+
+/**************************************************************************/
+bool ButtonStyle_TT::setFont(Font_TT* f) {
+
+  if (_f != f) {
+    _f = f;
+    applyToButtons();
+    return (true);
+  }
+  return (false);
+}
+
+/**************************************************************************/
+bool ButtonStyle_TT::setCornerRadius(int16_t rCorner) {
+
+  if (_rCorner != rCorner) {
+    _rCorner = rCorner;
+    applyToButtons();
+    return (true);
+  }
+  return (false);
+}
+
+/**************************************************************************/
+bool ButtonStyle_TT::setExpansion(uint8_t expU, uint8_t expD, uint8_t expL,
+    uint8_t expR) {
+
+  if (_expU != expU || _expD != expD || _expL != expL || _expR != expR) {
+    _expU = expU;
+    _expD = expD;
+    _expL = expL;
+    _expR = expR;
+    applyToButtons();
+    return (true);
+  }
+  return (false);
+}
+
+// -------------------------------------------------------------------------
@@ -0,0 +1,243 @@
+/*
+  ButtonStyle_TT.h - Defines C++ class ButtonStyle_TT, a set of button colors,
+  label font and alignment, corner radius, and touch margins shared by the
+  buttons that use it.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  The buttons of a screen usually come in a few styles: every key of a keypad
+  has the same colors, font, and corners, every readout another set. Giving
+  each button these attributes in initButton() repeats them for each button,
+  and changing them (for example to switch from a day to a night theme) means
+  calling the setters of every button.
+
+  A ButtonStyle_TT object holds one set of these attributes and a list of the
+  buttons that use it. A button added to the style with addButton() takes the
+  style's attributes (the text color, label alignment, font, and corner
+  radius only if it has a label). Changing an attribute of the style is a
+  single call that gives the new attributes to every button in its list at
+  once, marking those whose attributes changed, so the next drawIfChanged()
+  redraws them. Button_TT_collection::drawIfChanged() redraws all the changed
+  buttons of a collection at once.
+
+  The buttons keep the attributes they draw with, as before, so a button
+  needs no pointer to its style, and its own setters (such as setFillColor()
+  to highlight it) still work, until the style changes again. A button must
+  be removed from its style with removeButton() before it is destroyed.
+
+  Example:
+
+    ButtonStyle_TT keyStyle(ILI9341_WHITE, ILI9341_NAVY, ILI9341_WHITE, "C",
+      &font_Keys, 6);
+    ...
+    for (int i = 0; i < 12; i++)
+      keyStyle.addButton(keys[i]);
+    ...
+    // Night theme.
+    keyStyle.setColors(ILI9341_DARKGREY, ILI9341_BLACK, ILI9341_RED);
+    keypad.drawIfChanged();
+*/
+#ifndef ButtonStyle_TT_h
+#define ButtonStyle_TT_h
+
+#include <Arduino.h>
+#include <Button_TT.h>
+#include <Font_TT.h>
+
+// Maximum number of buttons that can use a style, at most 255. Each style
+// holds a pointer to each of them, so lower this on a processor with little
+// RAM if styles have fewer buttons.
+#define BUTTON_STYLE_TT_MAX_BUTTONS 40
+
+/**************************************************************************/
+/*!
+  @brief  A set of button attributes shared by the buttons that use it.
+*/
+/**************************************************************************/
+class ButtonStyle_TT {
+
+protected:
+
+  ButtonColor_TT _outlineColor; // Outline color.
+  ButtonColor_TT _fillColor;    // Fill color.
+  ButtonColor_TT _textColor;    // Label text color.
+  const char* _textAlign;       // Label alignment, see Button_TT_label.
+  Font_TT* _f;                  // Label font, nullptr for the built-in font.
+  int16_t _rCorner;             // Corner radius.
+  uint8_t _expU, _expD, _expL, _expR; // Touch margins.
+
+  // The buttons that use the style.
+  Button_TT* _buttons[BUTTON_STYLE_TT_MAX_BUTTONS];
+  uint8_t _numButtons;
+
+  /**************************************************************************/
+  // Give the attributes of the style to each of its buttons.
+  /**************************************************************************/
+  void applyToButtons(void);
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    outlineColor  Outline color, see Button_TT::initButton().
+    @param    fillColor     Fill color.
+    @param    textColor     Label text color, see Button_TT_label.
+    @param    textAlign     Label alignment.
+    @param    f             Label font, nullptr for the built-in font.
+    @param    rCorner       Radius of rounded corners, 0 for square corners.
+    @param    expU          Touch margins, see Button_TT::initButton().
+    @param    expD
+    @param    expL
+    @param    expR
+  */
+  /**************************************************************************/
+  ButtonStyle_TT(uint16_t outlineColor = 0, uint16_t fillColor = 0,
+      uint16_t textColor = 0, const char* textAlign = "C",
+      Font_TT* f = nullptr, int16_t rCorner = 0, uint8_t expU = 0,
+      uint8_t expD = 0, uint8_t expL = 0, uint8_t expR = 0) {
+    _outlineColor = outlineColor;
+    _fillColor = fillColor;
+    _textColor = textColor;
+    _textAlign = textAlign;
+    _f = f;
+    _rCorner = rCorner;
+    _expU = expU;
+    _expD = expD;
+    _expL = expL;
+    _expR = expR;
+    _numButtons = 0;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Add a button to the buttons that use the style, and give it the
+              style's attributes, marking it changed if they differ from its
+              own.
+    @param    button    The button.
+    @returns  true if successful or the button already uses the style, false
+              if the maximum number of buttons use it.
+  */
+  /**************************************************************************/
+  bool addButton(Button_TT& button);
+
+  /**************************************************************************/
+  /*!
+    @brief    Remove a button from the buttons that use the style. The button
+              keeps its current attributes.
+    @param    button    The button.
+    @returns  true if successful, false if the button didn't use the style.
+  */
+  /**************************************************************************/
+  bool removeButton(Button_TT& button);
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of buttons that use the style.
+    @returns  The number of buttons added with addButton().
+  */
+  /**************************************************************************/
+  uint8_t getNumButtons(void) { return (_numButtons); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get attributes of the style.
+  */
+  /**************************************************************************/
+  uint16_t getOutlineColor(void) { return (_outlineColor); }
+  uint16_t getFillColor(void) { return (_fillColor); }
+  uint16_t getTextColor(void) { return (_textColor); }
+  const char* getTextAlign(void) { return (_textAlign); }
+  Font_TT* getFont(void) { return (_f); }
+  int16_t getCornerRadius(void) { return (_rCorner); }
+  void getExpansion(uint8_t& expU, uint8_t& expD, uint8_t& expL,
+      uint8_t& expR) {
+    expU = _expU;
+    expD = _expD;
+    expL = _expL;
+    expR = _expR;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the colors of the style.
+    @param    outlineColor  Outline color.
+    @param    fillColor     Fill color.
+    @param    textColor     Label text color.
+    @returns  true if any color is different from the old one.
+  */
+  /**************************************************************************/
+  bool setColors(uint16_t outlineColor, uint16_t fillColor,
+    uint16_t textColor);
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the label alignment of the style.
+    @param    textAlign   Label alignment, see Button_TT_label.
+    @returns  true if different from the old one.
+  */
+  /**************************************************************************/
+  bool setTextAlign(const char* textAlign);
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the label font of the style.
+    @param    f   Label font, nullptr for the built-in font.
+    @returns  true if different from the old one.
+  */
+  /**************************************************************************/
+  bool setFont(Font_TT* f);
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the corner radius of the style.
+    @param    rCorner   Radius of rounded corners, 0 for square corners.
+    @returns  true if different from the old one.
+  */
+  /**************************************************************************/
+  bool setCornerRadius(int16_t rCorner);
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the touch margins of the style.
+    @param    expU    Touch margins, see Button_TT::initButton().
+    @param    expD
+    @param    expL
+    @param    expR
+    @returns  true if any margin is different from the old one.
+  */
+  /**************************************************************************/
+  bool setExpansion(uint8_t expU, uint8_t expD, uint8_t expL, uint8_t expR);
+};
+
+#endif // ButtonStyle_TT_h
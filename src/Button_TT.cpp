@@ -35,12 +35,26 @@
 
 #include <Arduino.h>
 #include <Button_TT.h>
+#if BUTTON_TT_DIRTY_RECTS
+#include <DirtyRects_TT.h>
+#endif
+#include <ButtonStyle_TT.h>
+#include <Clip_TT.h>
 
 // If debug enabled, include monitor_printf.h for printf to serial monitor.
 #if BUTTON_TT_DBG
 #include <monitor_printf.h>
 #endif
 
+// Check that the compact layout of the members holds.
+static_assert(sizeof(Button_TT) <= BUTTON_TT_SIZE,
+  "Button_TT is larger than BUTTON_TT_SIZE");
+
+// The display object shared by all buttons.
+#if BUTTON_TT_SHARED_GFX
+Adafruit_GFX* Button_TT::_gfx = nullptr;
+#endif
+
 /**************************************************************************/
 
 void Button_TT::initButton(Adafruit_GFX* gfx, const char* align, int16_t x,
@@ -48,7 +62,12 @@ void Button_TT::initButton(Adafruit_GFX* gfx, const char* align, int16_t x,
     uint16_t fillColor, uint8_t expU, uint8_t expD, uint8_t expL,
     uint8_t expR) {
 
+  #if BUTTON_TT_SHARED_GFX
+  if (gfx != nullptr)
+    _gfx = gfx;
+  #else
   _gfx = gfx;
+  #endif
   _w = w;
   _h = h;
   _expU = expU;
@@ -57,8 +76,14 @@ void Button_TT::initButton(Adafruit_GFX* gfx, const char* align, int16_t x,
   _expR = expR;
   _outlineColor = outlineColor;
   _fillColor = fillColor;
+  _drawFlags = BUTTON_TT_DRAW_TEXT;
+  setDrawFlag(BUTTON_TT_DRAW_OUTLINE, outlineColor);
+  setDrawFlag(BUTTON_TT_DRAW_FILL, fillColor);
   _inverted = false;
   _changedSinceLastDrawn = true;
+  #if BUTTON_TT_BACKGROUND
+  _drewFill = _drewOutline = false;
+  #endif
   _isPressed = false;
   _returnedLastAction = true;
   _delta = 0;
@@ -87,11 +112,44 @@ void Button_TT::initButton(Adafruit_GFX* gfx, const char* align, int16_t x,
 
 /**************************************************************************/
 
+#if BUTTON_TT_BACKGROUND
+bool Button_TT::restoreBackground(bool drawFill, bool drawOutline) {
+  bool restore = _background != nullptr &&
+    ((!drawFill && _drewFill) || (!drawOutline && _drewOutline));
+  if (restore) {
+    int16_t x, y;
+    uint16_t w, h;
+    getDrawnBounds(x, y, w, h);
+    _background->draw(_gfx, x, y, w, h);
+  }
+  _drewFill = drawFill;
+  _drewOutline = drawOutline;
+  return (restore);
+}
+#endif
+
+/**************************************************************************/
+
+void Button_TT::setChanged(void) {
+  _changedSinceLastDrawn = true;
+  #if BUTTON_TT_DIRTY_RECTS
+  if (_dirtyRects != nullptr)
+    _dirtyRects->addButton(*this);
+  #endif
+}
+
+/**************************************************************************/
+
 bool Button_TT::setPosition(int16_t xL, int16_t yT) {
   if (_xL != xL || _yT != yT) {
+    // The area the button leaves must be redrawn too.
+    #if BUTTON_TT_DIRTY_RECTS
+    if (_dirtyRects != nullptr)
+      _dirtyRects->addButton(*this);
+    #endif
     _xL = xL;
     _yT = yT;
-    _changedSinceLastDrawn = true;
+    setChanged();
     return (true);
   }
   return (false);
@@ -102,7 +160,8 @@ bool Button_TT::setPosition(int16_t xL, int16_t yT) {
 bool Button_TT::setOutlineColor(uint16_t outlineColor) {
   if (_outlineColor != outlineColor) {
     _outlineColor = outlineColor;
-    _changedSinceLastDrawn = true;
+    setDrawFlag(BUTTON_TT_DRAW_OUTLINE, outlineColor);
+    setChanged();
     return (true);
   }
   return (false);
@@ -113,7 +172,19 @@ bool Button_TT::setOutlineColor(uint16_t outlineColor) {
 bool Button_TT::setFillColor(uint16_t fillColor) {
   if (_fillColor != fillColor) {
     _fillColor = fillColor;
-    _changedSinceLastDrawn = true;
+    setDrawFlag(BUTTON_TT_DRAW_FILL, fillColor);
+    setChanged();
+    return (true);
+  }
+  return (false);
+}
+
+/**************************************************************************/
+
+bool Button_TT::setDrawFlags(uint8_t flags) {
+  if (_drawFlags != flags) {
+    _drawFlags = flags;
+    setChanged();
     return (true);
   }
   return (false);
@@ -125,24 +196,43 @@ void Button_TT::drawButton(bool inverted) {
   _inverted = inverted;
 
   uint16_t fill, outline;
+  bool drawFill, drawOutline;
   if (!_inverted) {
-    fill = _fillColor;
-    outline = _outlineColor;
+    fill = rgb(_fillColor);
+    outline = rgb(_outlineColor);
+    drawFill = draws(BUTTON_TT_DRAW_FILL);
+    drawOutline = draws(BUTTON_TT_DRAW_OUTLINE);
   } else {
-    fill = _outlineColor;
-    outline = _fillColor;
+    fill = rgb(_outlineColor);
+    outline = rgb(_fillColor);
+    drawFill = draws(BUTTON_TT_DRAW_OUTLINE);
+    drawOutline = draws(BUTTON_TT_DRAW_FILL);
   }
 
-  if (fill != TRANSPARENT_COLOR)
-    _gfx->fillRect(_xL, _yT, _w, _h, fill);
-  if (outline != TRANSPARENT_COLOR)
-    _gfx->drawRect(_xL, _yT, _w, _h, outline);
+  restoreBackground(drawFill, drawOutline);
+  if (drawFill)
+    Clip_TT::fillRect(_gfx, _xL, _yT, _w, _h, fill);
+  if (drawOutline)
+    Clip_TT::drawRect(_gfx, _xL, _yT, _w, _h, outline);
 
   _changedSinceLastDrawn = false;
 }
 
 /**************************************************************************/
 
+void Button_TT::applyStyle(ButtonStyle_TT& style) {
+  setOutlineColor(style.getOutlineColor());
+  setFillColor(style.getFillColor());
+  uint8_t expU, expD, expL, expR;
+  style.getExpansion(expU, expD, expL, expR);
+  _expU = expU;
+  _expD = expD;
+  _expL = expL;
+  _expR = expR;
+}
+
+/**************************************************************************/
+
 bool Button_TT::drawIfChanged(bool forceDraw) {
   if (_changedSinceLastDrawn || forceDraw) {
     drawButton(_inverted);
@@ -151,11 +241,4 @@ bool Button_TT::drawIfChanged(bool forceDraw) {
   return (false);
 }
 
-/**************************************************************************/
-
-bool Button_TT::contains(int16_t x, int16_t y) {
-  return ((x >= _xL - _expL) && (x < (int16_t)(_xL + _w + _expR)) &&
-          (y >= _yT - _expU) && (y < (int16_t)(_yT + _h + _expD)));
-}
-
 // -------------------------------------------------------------------------
@@ -54,10 +54,25 @@
 
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
+#include <Palette_TT.h>
 
 // Set BUTTON_TT_DBG to 1 to enable debug output via monitor.printf(), 0 if not.
 #define BUTTON_TT_DBG 0
 
+// Set BUTTON_TT_PALETTE to 1 to store the colors of buttons as one-byte
+// indices into the palette of class Palette_TT (see Palette_TT.h) instead of
+// RGB565 colors. All color arguments and return values of the button
+// functions are then palette indices, TRANSPARENT_COLOR is index 255, and
+// each color is looked up in the palette when the button is drawn.
+#define BUTTON_TT_PALETTE 0
+
+// Type of the colors stored in a button.
+#if BUTTON_TT_PALETTE
+typedef uint8_t ButtonColor_TT;
+#else
+typedef uint16_t ButtonColor_TT;
+#endif
+
 // Use this color to avoid having outline, button background, or label drawn.
 // Note: The ILI9341 controller actually uses all 16 bits as color info, 5 bits
 // for red and blue, and 6 bits for green. It internally maps these to 6 bits
@@ -66,7 +81,62 @@
 // there is no invalid value. So, what we will do is arbitrarily pick a color
 // value that is unlikely to be used anywhere. We will choose with the least
 // significant bit of the R, G, and B values being 1 and all other bits 0.
+#if BUTTON_TT_PALETTE
+const uint16_t TRANSPARENT_COLOR = 0xFF;
+#else
 const uint16_t TRANSPARENT_COLOR = 0x0841;
+#endif
+
+// Flags telling which parts of a button are drawn, see setDrawFlags(). Setting
+// a color to TRANSPARENT_COLOR clears its flag, and setting it to any other
+// color sets the flag, so the colors needn't be compared with
+// TRANSPARENT_COLOR each time the button is drawn.
+#define BUTTON_TT_DRAW_OUTLINE  0x01
+#define BUTTON_TT_DRAW_FILL     0x02
+#define BUTTON_TT_DRAW_TEXT     0x04
+
+// Set BUTTON_TT_TRANSPARENCY to 0 if no button has a transparent part. All
+// parts of all buttons are then drawn, whatever their flags, and the flag
+// tests are compiled out.
+#define BUTTON_TT_TRANSPARENCY 1
+
+// Set BUTTON_TT_SHARED_GFX to 1 if all buttons are drawn on the same display
+// object. A single display object pointer is then shared by all buttons
+// instead of each one holding its own, and initButton() with a nullptr
+// display object leaves it unchanged.
+#define BUTTON_TT_SHARED_GFX 0
+
+// Set BUTTON_TT_DIRTY_RECTS to 1 to use class DirtyRects_TT (see
+// DirtyRects_TT.h). Each button then holds a pointer to the dirty rectangle
+// list it is registered with, to which it adds its drawn area when it changes.
+#define BUTTON_TT_DIRTY_RECTS 0
+
+// Set BUTTON_TT_BACKGROUND to 1 to give buttons a background (see
+// Background_TT.h) that they restore before they are drawn with a transparent
+// fill. Each button then holds a pointer to its background.
+#define BUTTON_TT_BACKGROUND 0
+
+#if BUTTON_TT_BACKGROUND
+#include <Background_TT.h>
+#endif
+
+// Round n up to a multiple of the size of a pointer, for the size limits below.
+#define BUTTON_TT_ROUND(n) \
+  (((n) + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*))
+
+// Maximum size in bytes of a Button_TT object, checked with static_assert() in
+// Button_TT.cpp: its pointers (the virtual function table pointer, the name in
+// debug builds, the display object unless shared, and the dirty rectangle list
+// and background if enabled) and 20 bytes of coordinates, colors, margins and
+// flags. The size limit of each derived class is defined in its header file.
+// With the default settings and 4-byte pointers, a Button_TT object takes 28
+// bytes.
+#define BUTTON_TT_SIZE BUTTON_TT_ROUND( \
+  (1 + BUTTON_TT_DBG + !BUTTON_TT_SHARED_GFX + BUTTON_TT_DIRTY_RECTS + \
+  BUTTON_TT_BACKGROUND) * sizeof(void*) + 20)
+
+class DirtyRects_TT;
+class ButtonStyle_TT;
 
 /**************************************************************************/
 /*!
@@ -78,11 +148,33 @@ class Button_TT {
 
 protected:
 
-  // Arbitrary button name, to assist with debugging.
+  // The members are ordered by size and the flags are packed into bits, so a
+  // button takes no padding (see BUTTON_TT_SIZE).
+
+  // Arbitrary button name, to assist with debugging, kept only in debug
+  // builds.
+  #if BUTTON_TT_DBG
   const char* _name;
+  #endif
 
-  // The pixel-based display object used to draw on the display.
+  // The pixel-based display object used to draw on the display, shared by all
+  // buttons if BUTTON_TT_SHARED_GFX is 1.
+  #if BUTTON_TT_SHARED_GFX
+  static Adafruit_GFX* _gfx;
+  #else
   Adafruit_GFX* _gfx;
+  #endif
+
+  // Dirty rectangle list to which the button adds its drawn area when it
+  // changes, nullptr if none.
+  #if BUTTON_TT_DIRTY_RECTS
+  DirtyRects_TT* _dirtyRects;
+  #endif
+
+  // Background drawn behind the button, nullptr if none.
+  #if BUTTON_TT_BACKGROUND
+  Background_TT* _background;
+  #endif
 
   // Coordinates of top-left corner of button.
   int16_t _xL, _yT;
@@ -90,29 +182,103 @@ protected:
   // Width and height of button in pixels.
   uint16_t _w, _h;
 
+  // Reserved for derived classes to use to change something such as a value
+  // displayed inside the button.
+  int16_t _delta;
+
+  // Button outline and fill colors.
+  ButtonColor_TT _outlineColor, _fillColor;
+
   // Number of pixels to expand button bounding box to get coordinates of hit
   // box used to test for user hits on the button using a pointing device or
   // touchscreen.
-  uint16_t _expU, _expD, _expL, _expR;
+  uint8_t _expU, _expD, _expL, _expR;
 
-  // Button outline and fill colors.
-  uint16_t _outlineColor, _fillColor;
-
-  // Reserved for derived classes to use to change something such as a value
-  // displayed inside the button.
-  int16_t _delta;
+  // Parts of the button that are drawn, BUTTON_TT_DRAW_* flags.
+  uint8_t _drawFlags;
 
   // true while button colors are inverted.
-  bool _inverted;
+  bool _inverted : 1;
 
   // true if a visible attribute changes, cleared when button drawn.
-  bool _changedSinceLastDrawn;
+  bool _changedSinceLastDrawn : 1;
 
   // true if button is pressed.
-  bool _isPressed;
+  bool _isPressed : 1;
 
   // true if new value of _isPressed has been returned to caller.
-  bool _returnedLastAction;
+  bool _returnedLastAction : 1;
+
+  // true if the last drawing of the button filled it, or drew its outline.
+  #if BUTTON_TT_BACKGROUND
+  bool _drewFill : 1, _drewOutline : 1;
+  #endif
+
+  /**************************************************************************/
+  // Return the RGB565 color of button color 'color'.
+  /**************************************************************************/
+  static uint16_t rgb(ButtonColor_TT color) {
+    #if BUTTON_TT_PALETTE
+    return (Palette_TT::color(color));
+    #else
+    return (color);
+    #endif
+  }
+
+  /**************************************************************************/
+  // Set draw flag 'flag' if 'color' is not TRANSPARENT_COLOR, else clear it.
+  /**************************************************************************/
+  void setDrawFlag(uint8_t flag, uint16_t color) {
+    if (color != TRANSPARENT_COLOR)
+      _drawFlags |= flag;
+    else
+      _drawFlags &= ~flag;
+  }
+
+  /**************************************************************************/
+  // Return true if the part of the button given by draw flag 'flag' is drawn.
+  /**************************************************************************/
+  bool draws(uint8_t flag) {
+    #if BUTTON_TT_TRANSPARENCY
+    return ((_drawFlags & flag) != 0);
+    #else
+    (void)flag;
+    return (true);
+    #endif
+  }
+
+  /**************************************************************************/
+  // If the button has a background and is about to be drawn with its fill
+  // drawn if 'drawFill' is true and its outline drawn if 'drawOutline' is
+  // true, restore the background of the button's drawn area if its last
+  // drawing covered some of the background that this one won't. Return true
+  // if restored. Record what this drawing covers.
+  /**************************************************************************/
+  #if BUTTON_TT_BACKGROUND
+  bool restoreBackground(bool drawFill, bool drawOutline);
+  #else
+  bool restoreBackground(bool drawFill, bool drawOutline) {
+    (void)drawFill;
+    (void)drawOutline;
+    return (false);
+  }
+  #endif
+
+  /**************************************************************************/
+  // Note that a visible attribute of the button has changed: set
+  // _changedSinceLastDrawn and add the button's drawn area to _dirtyRects, if
+  // any.
+  /**************************************************************************/
+  void setChanged(void);
+
+  /**************************************************************************/
+  // Take the attributes of 'style', marking the button changed if they differ
+  // from its own. Called by ButtonStyle_TT for each of its buttons. Derived
+  // classes that have more of the style's attributes override this and call
+  // it.
+  /**************************************************************************/
+  virtual void applyStyle(ButtonStyle_TT& style);
+  friend class ButtonStyle_TT;
 
 public:
   /**************************************************************************/
@@ -127,7 +293,19 @@ public:
   Button_TT(const char* name, Adafruit_GFX* gfx = 0, const char* align = "C",
       int16_t x = 0, int16_t y = 0, uint16_t w = 0, uint16_t h = 0,
       uint16_t outlineColor = 0, uint16_t fillColor = 0, uint8_t expU = 0,
-      uint8_t expD = 0, uint8_t expL = 0, uint8_t expR = 0) : _name(name) {
+      uint8_t expD = 0, uint8_t expL = 0, uint8_t expR = 0) {
+
+    #if BUTTON_TT_DBG
+    _name = name;
+    #else
+    (void)name;
+    #endif
+    #if BUTTON_TT_DIRTY_RECTS
+    _dirtyRects = nullptr;
+    #endif
+    #if BUTTON_TT_BACKGROUND
+    _background = nullptr;
+    #endif
 
     initButton(gfx, align, x, y, w, h, outlineColor, fillColor, expU, expD,
       expL, expR);
@@ -198,6 +376,66 @@ public:
   /**************************************************************************/
   uint16_t getHeight() { return (_h); }
 
+  /**************************************************************************/
+  /*!
+    @brief    Get the rectangle containing all pixels that drawButton() draws.
+              This is the button rectangle, unless a derived class draws
+              outside it.
+    @param    x     Set to the left edge of the rectangle.
+    @param    y     Set to the top edge of the rectangle.
+    @param    w     Set to the width of the rectangle.
+    @param    h     Set to the height of the rectangle.
+  */
+  /**************************************************************************/
+  virtual void getDrawnBounds(int16_t& x, int16_t& y, uint16_t& w,
+      uint16_t& h) {
+    x = _xL;
+    y = _yT;
+    w = _w;
+    h = _h;
+  }
+
+  #if BUTTON_TT_DIRTY_RECTS
+  /**************************************************************************/
+  /*!
+    @brief    Set the dirty rectangle list to which the button adds its drawn
+              area when it changes. Called by DirtyRects_TT::registerButton().
+    @param    dirtyRects  The list, nullptr for none.
+  */
+  /**************************************************************************/
+  void setDirtyRects(DirtyRects_TT* dirtyRects) { _dirtyRects = dirtyRects; }
+  #endif
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the display object the button is drawn on.
+    @returns  The display object.
+  */
+  /**************************************************************************/
+  Adafruit_GFX* getGFX(void) { return (_gfx); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the display object the button is drawn on, without marking
+              the button changed. StripRender_TT uses this to draw the button
+              into its strip buffer.
+    @param    gfx   The display object.
+  */
+  /**************************************************************************/
+  void setGFX(Adafruit_GFX* gfx) { _gfx = gfx; }
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the background drawn behind the button, which the button
+              restores before it is drawn with a transparent fill, erasing
+              what it drew before.
+    @param    background  The background, nullptr for none.
+  */
+  /**************************************************************************/
+  #if BUTTON_TT_BACKGROUND
+  void setBackground(Background_TT* background) { _background = background; }
+  #endif
+
   /**************************************************************************/
   /*!
     @brief    Get current outline color for button.
@@ -232,6 +470,30 @@ public:
   /**************************************************************************/
   bool setFillColor(uint16_t fillColor);
 
+  /**************************************************************************/
+  /*!
+    @brief    Get the flags telling which parts of the button are drawn.
+    @returns  BUTTON_TT_DRAW_OUTLINE, BUTTON_TT_DRAW_FILL, and (for buttons
+              with labels) BUTTON_TT_DRAW_TEXT, or'ed together.
+  */
+  /**************************************************************************/
+  uint8_t getDrawFlags(void) { return (_drawFlags); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the flags telling which parts of the button are drawn. The
+              flags are also set when the colors are set, so this is needed
+              only to hide a part without changing its color, or to draw a
+              part whose color is TRANSPARENT_COLOR as an ordinary color. When
+              the button is drawn inverted, the flags of the swapped colors
+              are swapped too.
+    @param    flags   BUTTON_TT_DRAW_OUTLINE, BUTTON_TT_DRAW_FILL, and
+                      BUTTON_TT_DRAW_TEXT, or'ed together.
+    @returns  true if the flags are different from the old ones.
+  */
+  /**************************************************************************/
+  bool setDrawFlags(uint8_t flags);
+
   /**************************************************************************/
   /*!
     @brief    Get inversion flag for last draw.
@@ -240,6 +502,15 @@ public:
   /**************************************************************************/
   uint16_t getInverted(void) { return (_inverted); }
 
+  /**************************************************************************/
+  /*!
+    @brief    Query whether a visible attribute of the button has changed since
+              it was last drawn.
+    @returns  true if changed, and drawIfChanged() would draw the button.
+  */
+  /**************************************************************************/
+  bool hasChanged(void) { return (_changedSinceLastDrawn); }
+
   /**************************************************************************/
   /*!
     @brief    Draw the button on the screen.
@@ -274,11 +545,8 @@ public:
   */
   /**********************************************************************/
   void press() {
-    if (!_isPressed) {
-      _isPressed = true;
-      _returnedLastAction = false;
-      drawButton(_isPressed);
-    }
+    if (setPressed(true))
+      drawButton(true);
   }
 
   /**********************************************************************/
@@ -287,11 +555,25 @@ public:
   */
   /**********************************************************************/
   void release() {
-    if (_isPressed) {
-      _isPressed = false;
-      _returnedLastAction = false;
-      drawButton(_isPressed);
-    }
+    if (setPressed(false))
+      drawButton(false);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief    Set the pressed state of the button without drawing it, for
+              classes that draw the button themselves (see ButtonSet_TT.h).
+    @param    pressed   true to set the pressed state, false for released.
+    @returns  true if the state changed, and the button must be drawn with
+              drawButton(pressed).
+  */
+  /**********************************************************************/
+  bool setPressed(bool pressed) {
+    if (_isPressed == pressed)
+      return (false);
+    _isPressed = pressed;
+    _returnedLastAction = false;
+    return (true);
   }
 
   /**********************************************************************/
@@ -336,7 +618,10 @@ public:
     @returns  true if within button graphics outline.
   */
   /**************************************************************************/
-  bool contains(int16_t x, int16_t y);
+  bool contains(int16_t x, int16_t y) {
+    return ((x >= _xL - _expL) && (x < (int16_t)(_xL + _w + _expR)) &&
+            (y >= _yT - _expU) && (y < (int16_t)(_yT + _h + _expD)));
+  }
 
   /**************************************************************************/
   /*!
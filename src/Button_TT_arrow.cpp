@@ -33,12 +33,37 @@
 */
 #include <Arduino.h>
 #include <Button_TT_arrow.h>
+#include <Clip_TT.h>
 
 // If debug enabled, include monitor_printf.h for printf to serial monitor.
 #if BUTTON_TT_DBG
 #include <monitor_printf.h>
 #endif
 
+// Check that the compact layout of the members holds.
+static_assert(sizeof(Button_TT_arrow) <= BUTTON_TT_ARROW_SIZE,
+  "Button_TT_arrow is larger than BUTTON_TT_ARROW_SIZE");
+
+/**************************************************************************/
+// Return the integer square root of n, the largest integer whose square is
+// not greater than n.
+/**************************************************************************/
+static uint16_t isqrt(uint32_t n) {
+  uint32_t root = 0;
+  uint32_t bit = (uint32_t)1 << 30;
+  while (bit > n)
+    bit >>= 2;
+  while (bit != 0) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else
+      root >>= 1;
+    bit >>= 2;
+  }
+  return ((uint16_t)root);
+}
+
 /**************************************************************************/
 
 void Button_TT_arrow::initButton(Adafruit_GFX* gfx, char orient,
@@ -50,6 +75,7 @@ void Button_TT_arrow::initButton(Adafruit_GFX* gfx, char orient,
   _orient = orient;
   _s1 = s1;
   _s2 = s2;
+  _spans = nullptr;
 
   // Pre-initialize base class with null values except gfx.
   Button_TT::initButton(gfx);
@@ -69,8 +95,10 @@ void Button_TT_arrow::initButton(Adafruit_GFX* gfx, char orient,
   // are the hypotenuses of right triangles whose base is s1/2, giving the
   // height of the triangle as sqrt(s2^2 - s1^2/4).  If L or R, reverse the
   // role of s1 and s2.
+  uint32_t s1s1 = (uint32_t)s1 * s1 / 4;
+  uint32_t s2s2 = (uint32_t)s2 * s2;
   w = s1;
-  h = (uint16_t)(1.0 + sqrt(s2 * s2 - s1 * s1 / 4));
+  h = 1 + ((s2s2 > s1s1) ? isqrt(s2s2 - s1s1) : 0);
   if (orient == 'L' || orient == 'R') {
     w = h;
     h = s1;
@@ -98,6 +126,10 @@ void Button_TT_arrow::initButton(Adafruit_GFX* gfx, char orient,
 
   // Initialize _delta according to button orientation.
   _delta = (orient == 'L' || orient == 'U') ? -1 : +1;
+
+  // Get the triangle's row spans, computing them if no other arrow has
+  // this size and orientation.
+  _spans = Shapes_TT::arrowSpans(_w, _h, _orient);
 }
 
 /**************************************************************************/
@@ -106,51 +138,48 @@ void Button_TT_arrow::drawButton(bool inverted) {
 
   _inverted = inverted;
 
-  // Triangle vertices, 0=tip, CW for 1 and 2.
-  int16_t x0, y0, x1, y1, x2,  y2;
-
-  // Compute coords of vertices using orient, _xL, _yT, _w, and _h.
-  x0 = x1 = x2 = _xL;
-  y0 = y1 = y2 = _yT;
-  if (_orient == 'U') {
-    x0 += _w / 2;
-    x1 += _w;
-    y1 += _h;
-    y2 += _h;
-  } else if (_orient == 'D') {
-    x0 += _w / 2;
-    y0 += _h;
-    x2 += _w;
-  } else if (_orient == 'L') {
-    y0 += _h / 2;
-    x1 += _w;
-    x2 += _w;
-    y2 += _h;
-  } else { // Assume 'R'
-    x0 += _w;
-    y0 += _h / 2;
-    y1 += _h;
-  }
-
   #if BUTTON_TT_DBG
   monitor.printf(
-    "Draw arrow:  Name: %s  x0: %d  y0: %d  x1: %d  y1: %d  x2: %d  y2: %d\n",
-    x0, y0, x1, y1, x2, y2);
+    "Draw arrow:  Name: %s  orient: %c  x: %d  y: %d  w: %d  h: %d\n",
+    _name, _orient, _xL, _yT, _w, _h);
   #endif
 
   uint16_t fill, outline;
+  bool drawFill, drawOutline;
   if (!_inverted) {
-    fill = _fillColor;
-    outline = _outlineColor;
+    fill = rgb(_fillColor);
+    outline = rgb(_outlineColor);
+    drawFill = draws(BUTTON_TT_DRAW_FILL);
+    drawOutline = draws(BUTTON_TT_DRAW_OUTLINE);
   } else {
-    fill = _outlineColor;
-    outline = _fillColor;
+    fill = rgb(_outlineColor);
+    outline = rgb(_fillColor);
+    drawFill = draws(BUTTON_TT_DRAW_OUTLINE);
+    drawOutline = draws(BUTTON_TT_DRAW_FILL);
   }
 
-  if (fill != TRANSPARENT_COLOR)
-    _gfx->fillTriangle(x0, y0, x1, y1, x2, y2, fill);
-  if (outline != TRANSPARENT_COLOR)
-    _gfx->drawTriangle(x0, y0, x1, y1, x2, y2, outline);
+  restoreBackground(drawFill, drawOutline);
+  if (_spans != nullptr) {
+    if (drawFill)
+      Shapes_TT::fillArrow(_gfx, _xL, _yT, _h, _spans, fill);
+    if (drawOutline)
+      Shapes_TT::drawArrow(_gfx, _xL, _yT, _h, _spans, outline);
+  } else {
+    // The arrow has no table (see Shapes_TT::arrowSpans()), so draw it from
+    // its vertices.
+    int16_t vx[3], vy[3];
+    Shapes_TT::arrowVertices(_w, _h, _orient, vx, vy);
+    for (uint8_t i = 0; i < 3; i++) {
+      vx[i] += _xL;
+      vy[i] += _yT;
+    }
+    ClipGFX_TT clipped(_gfx);
+    Adafruit_GFX* gfx = Clip_TT::isClipped() ? &clipped : _gfx;
+    if (drawFill)
+      gfx->fillTriangle(vx[0], vy[0], vx[1], vy[1], vx[2], vy[2], fill);
+    if (drawOutline)
+      gfx->drawTriangle(vx[0], vy[0], vx[1], vy[1], vx[2], vy[2], outline);
+  }
 
   _changedSinceLastDrawn = false;
 }
@@ -52,6 +52,13 @@
 
 #include <Arduino.h>
 #include <Button_TT.h>
+#include <Shapes_TT.h>
+
+// Maximum size in bytes of a Button_TT_arrow object, checked with
+// static_assert() in Button_TT_arrow.cpp: a Button_TT object plus a pointer
+// and 5 bytes.
+#define BUTTON_TT_ARROW_SIZE \
+  BUTTON_TT_ROUND(BUTTON_TT_SIZE + sizeof(void*) + 5)
 
 /**************************************************************************/
 /*!
@@ -64,12 +71,17 @@ class Button_TT_arrow : public Button_TT {
 
 protected:
 
-  // Orientation of triangle: U=UP, D=DOWN, L=LEFT, R=RIGHT.
-  char _orient;
+  // Row spans of the triangle, shared by all arrows of the same size and
+  // orientation (see Shapes_TT::arrowSpans()), nullptr if the triangle is
+  // drawn with Adafruit_GFX functions instead.
+  const Shapes_TT::ArrowSpan_TT* _spans;
 
   // Lengths of triangle sides, base side is _s1, lateral sides are _s2.
   uint16_t _s1, _s2;
 
+  // Orientation of triangle: U=UP, D=DOWN, L=LEFT, R=RIGHT.
+  char _orient;
+
 public:
   /**************************************************************************/
   /*!
@@ -121,6 +133,22 @@ public:
   /**************************************************************************/
   char getOrientation(void) { return (_orient); }
 
+  /**************************************************************************/
+  /*!
+    @brief    Get the rectangle containing all pixels that drawButton() draws,
+              see Button_TT::getDrawnBounds(). The triangle's vertices lie on
+              the right and bottom edges of the button rectangle, so its
+              pixels extend one pixel past them.
+  */
+  /**************************************************************************/
+  void getDrawnBounds(int16_t& x, int16_t& y, uint16_t& w, uint16_t& h)
+      override {
+    x = _xL;
+    y = _yT;
+    w = _w + 1;
+    h = _h + 1;
+  }
+
   /**************************************************************************/
   /*!
     @brief    Draw the button on the screen.
@@ -110,4 +110,14 @@ bool Button_TT_collection::release() {
   return (true);
 }
 
+/**************************************************************************/
+
+uint8_t Button_TT_collection::drawIfChanged(bool forceDraw) {
+  uint8_t n = 0;
+  for (int i = 0; i < numRegisteredButtons; i++)
+    if (buttons[i]->drawIfChanged(forceDraw))
+      n++;
+  return (n);
+}
+
 // -------------------------------------------------------------------------
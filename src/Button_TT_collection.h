@@ -152,6 +152,17 @@ public:
     @returns  false if no button was previously pressed, else true.
   */
   bool release();
+
+  /**************************************************************************/
+  /*!
+    @brief    Redraw each registered button that has changed since it was last
+              drawn (see Button_TT::drawIfChanged()), for example after a
+              change to a style used by the buttons (see ButtonStyle_TT.h).
+    @param    forceDraw     If true, all registered buttons are drawn.
+    @returns  The number of buttons drawn.
+  */
+  /**************************************************************************/
+  uint8_t drawIfChanged(bool forceDraw = false);
 };
 
 #endif // Button_TT_collection_h
@@ -34,6 +34,10 @@
 #include <Arduino.h>
 #include <Button_TT_int16.h>
 
+// Check that the compact layout of the members holds.
+static_assert(sizeof(Button_TT_int16) <= BUTTON_TT_INT16_SIZE,
+  "Button_TT_int16 is larger than BUTTON_TT_INT16_SIZE");
+
 /**************************************************************************/
 
 void Button_TT_int16::initButton(
@@ -89,7 +93,7 @@ bool Button_TT_int16::setValue(int16_t value, bool dontCheck) {
     *p++ = '+';
   itoa(_value, p, 10);
   setLabel(S);
-  _changedSinceLastDrawn = true;
+  setChanged();
   return (true);
 }
 
@@ -98,7 +102,7 @@ bool Button_TT_int16::setValue(int16_t value, bool dontCheck) {
 bool Button_TT_int16::setValueAndDrawIfChanged(int16_t value, bool forceDraw) {
   setValue(value);
   if (_changedSinceLastDrawn || forceDraw) {
-    drawButton();
+    drawLabelChange(forceDraw);
     return (true);
   }
   return (false);
@@ -50,6 +50,12 @@
 #include <Button_TT_label.h>
 #include <Button_TT_arrow.h>
 
+// Maximum size in bytes of a Button_TT_int16 object, checked with
+// static_assert() in Button_TT_int16.cpp: a Button_TT_label object plus a
+// pointer and 7 bytes.
+#define BUTTON_TT_INT16_SIZE \
+  BUTTON_TT_ROUND(BUTTON_TT_LABEL_SIZE + sizeof(void*) + 7)
+
 /**************************************************************************/
 /*!
   @brief  A class that enhances class Button_TT_label by supplying an int16_t
@@ -60,15 +66,15 @@ class Button_TT_int16 : public Button_TT_label {
 
 protected:
 
+  // Function to call to check if a new button value is valid.
+  int16_t (*_checkValue)(Button_TT_int16 &btn, int16_t value);
+
   // The current button value that is displayed, and its minimum and maximum.
   int16_t _value, _minValue, _maxValue;
 
   // true to show "+".
   bool _showPlus;
 
-  // Function to call to check if a new button value is valid.
-  int16_t (*_checkValue)(Button_TT_int16 &btn, int16_t value);
-
 public:
   /**************************************************************************/
   /*!
@@ -186,7 +192,8 @@ public:
               last drawn.
     @param    value       The int16_t value for the button.
     @param    forceDraw   If true, the button is drawn even if attributes have
-                          not changed.
+                          not changed, and all of it is drawn (see
+                          Button_TT_label::setLabelAndDrawIfChanged()).
     @returns  true if button was drawn.
   */
   /**************************************************************************/
@@ -34,6 +34,10 @@
 #include <Arduino.h>
 #include <Button_TT_int8.h>
 
+// Check that the compact layout of the members holds.
+static_assert(sizeof(Button_TT_int8) <= BUTTON_TT_INT8_SIZE,
+  "Button_TT_int8 is larger than BUTTON_TT_INT8_SIZE");
+
 /**************************************************************************/
 
 void Button_TT_int8::initButton(
@@ -90,7 +94,7 @@ bool Button_TT_int8::setValue(int8_t value, bool dontCheck) {
     *p++ = '+';
   itoa(_value, p, 10);
   setLabel(S);
-  _changedSinceLastDrawn = true;
+  setChanged();
   return (true);
 }
 
@@ -99,7 +103,7 @@ bool Button_TT_int8::setValue(int8_t value, bool dontCheck) {
 bool Button_TT_int8::setValueAndDrawIfChanged(int8_t value, bool forceDraw) {
   setValue(value);
   if (_changedSinceLastDrawn || forceDraw) {
-    drawButton();
+    drawLabelChange(forceDraw);
     return (true);
   }
   return (false);
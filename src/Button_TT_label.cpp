@@ -29,6 +29,10 @@
 */
 #include <Arduino.h>
 #include <Button_TT_label.h>
+#include <ButtonStyle_TT.h>
+#include <TextRender_TT.h>
+#include <Shapes_TT.h>
+#include <Clip_TT.h>
 #include <pgmspace_GFX.h>
 
 // If debug enabled, include monitor_printf.h for printf to serial monitor.
@@ -36,6 +40,10 @@
 #include <monitor_printf.h>
 #endif
 
+// Check that the compact layout of the members holds.
+static_assert(sizeof(Button_TT_label) <= BUTTON_TT_LABEL_SIZE,
+  "Button_TT_label is larger than BUTTON_TT_LABEL_SIZE");
+
 // Define "min" and "max" functions.
 #ifndef min
 #define min(a, b) (((a) < (b)) ? (a) : (b))
@@ -61,13 +69,11 @@ void Button_TT_label::getWidestValue(int32_t minValue, int32_t maxValue,
 
   // Get width of each digit if we don't already have it.
   if (!haveDigitWidths) {
-    char t[2];
-    t[1] = 0;
-    for (uint8_t i = 0; i < 10; i++) {
-      t[0] = (char)((uint8_t)'0' + i);
-      _f->getTextBoundsAndOffset(t, dX, dY, wt2, ht2, dXcF);
-      digitWidths[i] = wt2;
-    }
+    TextBounds_TT tb[10];
+    _f->getPackedTextBoundsAndOffset(
+      "0\0" "1\0" "2\0" "3\0" "4\0" "5\0" "6\0" "7\0" "8\0" "9", 10, tb);
+    for (uint8_t i = 0; i < 10; i++)
+      digitWidths[i] = tb[i].wt;
 
     // Get the widest digit.
     widestDigit = 1;
@@ -203,15 +209,21 @@ void Button_TT_label::getDegreeSymSize(int8_t &dx, int8_t &dy, int8_t &xa,
   // where the degree symbol is printed to get the y-position of the next char.
 
   // Get xOffset, yOffset, xAdvance, and height of character '"' using the
-  // current font table.
-  const GFXfont* font = _f->getFont();
-  uint8_t first = pgm_read_byte(&font->first);
-  GFXglyph* glyph;
-  glyph = pgm_read_glyph_ptr(font, '"' - first);
-  dx = pgm_read_byte(&glyph->xOffset);
-  dy = pgm_read_byte(&glyph->yOffset);
-  xa = pgm_read_byte(&glyph->xAdvance);
-  d = pgm_read_byte(&glyph->height);
+  // current font table. The built-in font has no glyph table, its characters
+  // are 6x8 cells whose top-left corner is at the cursor position, and its "
+  // character is 3 pixels high.
+  const GFXglyph* glyph = _f->getGlyph('"');
+  if (glyph != nullptr) {
+    dx = pgm_read_byte(&glyph->xOffset);
+    dy = pgm_read_byte(&glyph->yOffset);
+    xa = pgm_read_byte(&glyph->xAdvance);
+    d = pgm_read_byte(&glyph->height);
+  } else {
+    dx = 0;
+    dy = 0;
+    xa = 6;
+    d = 3;
+  }
 
   // Compute radius of outside and inside of degree symbol. Make the difference
   // between the two be about 3/11 of the diameter.
@@ -237,10 +249,17 @@ void Button_TT_label::updateLabelSizeForDegreeSymbol(int16_t dX, int16_t &dY,
 
   // Initially, the arguments reflect the size and relative cursor position of
   // the label without the degree symbol. We update them to include the degree
-  // symbol.
+  // symbol, which is the font's degree sign glyph if it has one.
 
-  _f->newTextBoundsAndOffset(dX, dY, wt, ht, dXcF, _dx_degree, _dy_degree,
-    _d_degree, _d_degree, _xa_degree, dY, wt, ht, dXcF);
+  if (_degreeGlyph) {
+    TextBounds_TT tb;
+    _f->getCharBoundsAndOffset(DEGREE_SIGN_CODE_POINT, tb);
+    _f->newTextBoundsAndOffset(dX, dY, wt, ht, dXcF, tb.dX, tb.dY, tb.wt,
+      tb.ht, tb.dXcF, dY, wt, ht, dXcF);
+  } else {
+    _f->newTextBoundsAndOffset(dX, dY, wt, ht, dXcF, _dx_degree, _dy_degree,
+      _d_degree, _d_degree, _xa_degree, dY, wt, ht, dXcF);
+  }
 }
 
 /**************************************************************************/
@@ -253,11 +272,21 @@ void Button_TT_label::initButton(Adafruit_GFX* gfx, const char* align,
   _textColor = textColor;
   _textAlign = "";
   setTextAlign(textAlign);
-  _label = nullptr;
   setLabel(label);
   _degreeSym = degreeSym;
   _f = (f != nullptr) ? f : &builtInFont;
+  _degreeGlyph = _degreeSym && _f->getGlyph(DEGREE_SIGN_CODE_POINT) != nullptr;
   _rCorner = rCorner;
+  #if BUTTON_TT_LABEL_CACHE
+  _glyphCache = nullptr;
+  #endif
+  #if BUTTON_TT_BODY_REDRAW
+  _cornersDrawn = false;
+  _redrawBody = false;
+  #endif
+  #if BUTTON_TT_BACKGROUND
+  _labelW = 0;
+  #endif
   _dx_degree = _dy_degree = _xa_degree = _d_degree = _rO_degree = _rI_degree =
       0;
 
@@ -284,26 +313,30 @@ void Button_TT_label::initButton(Adafruit_GFX* gfx, const char* align,
     #endif
   }
 
-  // If degree symbol is used, get its size data.
-  if (_degreeSym) {
+  // If degree symbol circle is used, get its size data.
+  if (_degreeSym && !_degreeGlyph) {
     getDegreeSymSize(_dx_degree, _dy_degree, _xa_degree, _d_degree, _rO_degree,
                      _rI_degree);
+    // Compute the rows of the ring now rather than when drawing it.
+    Shapes_TT::cornerInsets(_rO_degree);
+    Shapes_TT::cornerInsets(_rI_degree);
     #if BUTTON_TT_DBG
     monitor.printf(
       "  Degree symbol d: %d  rO: %d  rI: %d  dX: %d  dY: %d  xA: %d\n",
       _d_degree, _rO_degree, _rI_degree, _dx_degree, _dy_degree, _xa_degree);
     #endif
+  }
 
-    // If auto-sizing the button, update the button size and delta cursor values.
-    if (autoSize) {
-      updateLabelSizeForDegreeSymbol(dX, dY, dXcF, w_label, h_label);
+  // If auto-sizing the button with a degree symbol, update the button size and
+  // delta cursor values.
+  if (_degreeSym && autoSize) {
+    updateLabelSizeForDegreeSymbol(dX, dY, dXcF, w_label, h_label);
 
-      #if BUTTON_TT_DBG
-      monitor.printf(
-        "  Final w_label: %d  h_label: %d  dY_label: %d  dXcF_label: %d\n",
-        w_label, h_label, dY, dXcF);
-      #endif
-    }
+    #if BUTTON_TT_DBG
+    monitor.printf(
+      "  Final w_label: %d  h_label: %d  dY_label: %d  dXcF_label: %d\n",
+      w_label, h_label, dY, dXcF);
+    #endif
   }
 
   // If auto sizing, compute the actual button width/height by adding to
@@ -323,6 +356,7 @@ void Button_TT_label::initButton(Adafruit_GFX* gfx, const char* align,
   // Now call the base class initButton().
   Button_TT::initButton(gfx, align, x, y, (uint16_t)w, (uint16_t)h,
     outlineColor, fillColor, expU, expD, expL, expR);
+  setDrawFlag(BUTTON_TT_DRAW_TEXT, _textColor);
 }
 
 /**************************************************************************/
@@ -330,7 +364,8 @@ bool Button_TT_label::setTextColor(uint16_t textColor) {
 
   if (_textColor != textColor) {
     _textColor = textColor;
-    _changedSinceLastDrawn = true;
+    setDrawFlag(BUTTON_TT_DRAW_TEXT, textColor);
+    setChanged();
     return (true);
   }
   return (false);
@@ -343,7 +378,7 @@ bool Button_TT_label::setTextAlign(const char* textAlign) {
     textAlign = "CC";
   if (strcmp(_textAlign, textAlign) != 0) {
     _textAlign = textAlign;
-    _changedSinceLastDrawn = true;
+    setChanged();
     return (true);
   }
   return (false);
@@ -356,15 +391,38 @@ bool Button_TT_label::setFont(Font_TT* f) {
     f = &builtInFont;
   if (*_f != *f) {
     _f = f;
-    _changedSinceLastDrawn = true;
+    _degreeGlyph = _degreeSym &&
+      _f->getGlyph(DEGREE_SIGN_CODE_POINT) != nullptr;
+    if (_degreeSym && !_degreeGlyph)
+      getDegreeSymSize(_dx_degree, _dy_degree, _xa_degree, _d_degree,
+        _rO_degree, _rI_degree);
+    setChanged();
     return (true);
   }
   return (false);
 }
 
+/**************************************************************************/
+void Button_TT_label::applyStyle(ButtonStyle_TT& style) {
+
+  Button_TT::applyStyle(style);
+  setTextColor(style.getTextColor());
+  setTextAlign(style.getTextAlign());
+  setFont(style.getFont());
+  if (_rCorner != style.getCornerRadius()) {
+    _rCorner = style.getCornerRadius();
+    #if BUTTON_TT_BODY_REDRAW
+    _cornersDrawn = false;
+    #endif
+    setChanged();
+  }
+}
+
 /**************************************************************************/
 bool Button_TT_label::setLabel(const char* label) {
 
+  if (label == nullptr)
+    label = "";
   if (_label != nullptr) {
     if (strcmp(label, _label) == 0)
       return (false);
@@ -376,7 +434,7 @@ bool Button_TT_label::setLabel(const char* label) {
   if (_label == nullptr)
     _label = (char*)malloc(strlen(label) + 1);
   strcpy(_label, label);
-  _changedSinceLastDrawn = true;
+  setChanged();
   return (true);
 }
 
@@ -403,39 +461,67 @@ bool Button_TT_label::printf(const char* format, ...) {
   return (ret);
 }
 
+#if BUTTON_TT_LABEL_CACHE
+/**************************************************************************/
+bool Button_TT_label::drawLabelCached(int16_t xI, int16_t yI, int16_t wI,
+    int16_t hI, int16_t &xC, int16_t &yC, uint16_t text, uint16_t fill) {
+
+  // Get the band of the label's character cells, from xC to xF horizontally
+  // and yB to yB+hB vertically.
+  int16_t dY, xL, yT, xF, yF;
+  uint16_t hB, wt, ht;
+  _glyphCache->getFontExtent(_f, dY, hB);
+  _f->getTextBounds(_label, xC, yC, &xL, &yT, &wt, &ht, &xF, &yF);
+  int16_t yB = yC + dY;
+  if (yF != yC || xC < xI || xF > xI + wI || yB < yI ||
+      yB + (int16_t)hB > yI + hI)
+    return (false);
+
+  int16_t xS = xC;
+  TextRender_TT::drawTextCached(_gfx, _f, _glyphCache, xC, yC, _label, text,
+    fill);
+  Clip_TT::fillRect(_gfx, xI, yI, wI, yB - yI, fill);
+  Clip_TT::fillRect(_gfx, xI, yB + hB, wI, yI + hI - yB - hB, fill);
+  Clip_TT::fillRect(_gfx, xI, yB, xS - xI, hB, fill);
+  Clip_TT::fillRect(_gfx, xC, yB, xI + wI - xC, hB, fill);
+  return (true);
+}
+#endif
+
 /**************************************************************************/
 void Button_TT_label::drawButton(bool inverted) {
   _inverted = inverted;
 
   uint16_t fill, outline, text;
+  bool drawFill, drawText;
+  bool drawOutline = draws(BUTTON_TT_DRAW_OUTLINE);
   if (!_inverted) {
-    fill = _fillColor;
-    outline = _outlineColor;
-    text = _textColor;
+    fill = rgb(_fillColor);
+    outline = rgb(_outlineColor);
+    text = rgb(_textColor);
+    drawFill = draws(BUTTON_TT_DRAW_FILL);
+    drawText = draws(BUTTON_TT_DRAW_TEXT);
   } else {
-    fill = _textColor;
-    outline = _outlineColor;
-    text = _fillColor;
+    fill = rgb(_textColor);
+    outline = rgb(_outlineColor);
+    text = rgb(_fillColor);
+    drawFill = draws(BUTTON_TT_DRAW_TEXT);
+    drawText = draws(BUTTON_TT_DRAW_FILL);
   }
 
-  if (fill != TRANSPARENT_COLOR || outline != TRANSPARENT_COLOR) {
-    if (_rCorner == 0) {
-      if (fill != TRANSPARENT_COLOR)
-        _gfx->fillRect(_xL, _yT, _w, _h, fill);
-      if (outline != TRANSPARENT_COLOR)
-        _gfx->drawRect(_xL, _yT, _w, _h, outline);
-    } else {
-      if (fill != TRANSPARENT_COLOR)
-        _gfx->fillRoundRect(_xL, _yT, _w, _h, _rCorner, fill);
-      if (outline != TRANSPARENT_COLOR)
-        _gfx->drawRoundRect(_xL, _yT, _w, _h, _rCorner, outline);
-    }
-  }
+  bool showLabel = _label[0] != 0 && drawText;
+
+  // Anti-aliased font pixels are blended with the fill color, if there is one.
+  uint16_t blendBg = drawFill ? fill : text;
 
-  if (_label[0] != 0 && text != TRANSPARENT_COLOR) {
+  // (xStart, yBase) is the coords to set cursor to print the label, and yL to
+  // yL+hL are the rows it occupies.
+  int16_t xStart = 0, yBase = 0, yL = 0, dX = 0;
+  uint16_t hL = 0, wt = 0;
+  if (showLabel) {
     // Compute the size of the label to align it according to _textAlign.
-    int16_t dX, dY, dXcF;
-    uint16_t wt, ht;
+    int16_t dY, dXcF;
+    uint16_t ht;
     _f->getTextBoundsAndOffset(_label, dX, dY, wt, ht, dXcF);
     if (_degreeSym) {
       updateLabelSizeForDegreeSymbol(dX, dY, dXcF, wt, ht);
@@ -451,35 +537,111 @@ void Button_TT_label::drawButton(bool inverted) {
     // left corner of the text label bounding box was the correct position
     // for the cursor for drawing the text.
     // The label is aligned within the button according to _textAlign.
-    // (xStart, yBase) is the coords to set cursor to print the label
-
-    int16_t xStart, yBase;
     _f->getTextAlignCursor(dX, dY, wt, ht, _xL, _yT, _w, _h, _textAlign[1],
                            _textAlign[0], xStart, yBase);
+    yL = yBase + dY;
+    hL = ht;
 
     #if BUTTON_TT_DBG
     monitor.printf(
       "Name: %s  Label: %s  xStart: %d  yBase: %d    dX: %d  dY: %d  wt: %d  ht: %d\n",
       _name, _label, xStart, yBase, dX, dY, wt, ht);
     #endif
+  }
+
+  // The body of the button is the part inside the outline and between the
+  // rounded corners, which lie in the r rows at the top and bottom (r is
+  // limited as in Shapes_TT). A label lying in the body is drawn with an
+  // opaque background that fills the body in the same pass, so the body isn't
+  // filled first. A square-cornered button's body is all of its inside, and
+  // its label is clipped to it.
+  int16_t r = min(_rCorner, min(_w, _h) / 2);
+  if (r < 0)
+    r = 0;
+  int16_t b = drawOutline ? 1 : 0;
+  int16_t bT = max(r, b);
+  int16_t xB = _xL + b, yB = _yT + bT, wB = _w - 2 * b, hB = _h - 2 * bT;
+  bool inBody = r == 0 || !showLabel || (yL >= yB && yL + hL <= yB + hB);
+  bool opaque = drawFill && showLabel && inBody;
+
+  // For a label change, the body alone is redrawn if the corners are
+  // unchanged and the old label also lay in the body.
+  #if BUTTON_TT_BODY_REDRAW
+  bool bodyOnly = _redrawBody && _cornersDrawn && drawFill && r > 0 &&
+    inBody && _cornerX == _xL && _cornerY == _yT && _cornerFill == fill &&
+    _cornerOutline == outline && _cornersOutlined == drawOutline;
+  _redrawBody = false;
+  #else
+  bool bodyOnly = false;
+  #endif
+
+  // Over a background, a transparent fill doesn't erase the old label, so
+  // restore the background inside the button where it was drawn, unless the
+  // whole button's background is restored.
+  #if BUTTON_TT_BACKGROUND
+  if (!restoreBackground(drawFill, drawOutline) && !drawFill &&
+      _background != nullptr && _labelW > 0) {
+    bool clipped = Clip_TT::push(_xL + b, _yT + b, _w - 2 * b, _h - 2 * b);
+    _background->draw(_gfx, _labelX, _labelY, _labelW, _labelH);
+    if (clipped)
+      Clip_TT::pop();
+  }
+  _labelX = xStart + dX;
+  _labelY = yL;
+  _labelW = showLabel ? wt : 0;
+  _labelH = hL;
+  #endif
+
+  if (r == 0) {
+    if (drawFill && !opaque)
+      Clip_TT::fillRect(_gfx, _xL, _yT, _w, _h, fill);
+    if (drawOutline)
+      Clip_TT::drawRect(_gfx, _xL, _yT, _w, _h, outline);
+  } else if (bodyOnly) {
+    if (!opaque && hB > 0)
+      Clip_TT::fillRect(_gfx, xB, yB, wB, hB, fill);
+  } else {
+    if (drawFill)
+      Shapes_TT::fillRoundRect(_gfx, _xL, _yT, _w, _h, r, fill, opaque);
+    if (drawOutline)
+      Shapes_TT::drawRoundRect(_gfx, _xL, _yT, _w, _h, r, outline);
+  }
+  #if BUTTON_TT_BODY_REDRAW
+  _cornersDrawn = r > 0 && inBody && drawFill;
+  _cornersOutlined = drawOutline;
+  _cornerX = _xL;
+  _cornerY = _yT;
+  _cornerFill = fill;
+  _cornerOutline = outline;
+  #endif
 
-    // Now display the label.
-    _gfx->setTextColor(text);
-    // Note: setCursor must be called AFTER setFont, because for some reason
-    // setFont() mucks with the cursor y-position even though it shouldn't.
-    _gfx->setFont(_f->getFont());
-    _gfx->setCursor(xStart, yBase);
-    _gfx->setTextSize(_f->getTextSizeX(), _f->getTextSizeY());
-    _gfx->print(_label);
+  if (showLabel) {
+    // Now display the label, clipped to the inside of the button. (xC, yC) is
+    // the cursor position after the label.
+    bool clipped = Clip_TT::push(_xL + b, _yT + b, _w - 2 * b, _h - 2 * b);
+    int16_t xC = xStart, yC = yBase;
+    if (opaque) {
+      #if BUTTON_TT_LABEL_CACHE
+      if (_glyphCache == nullptr || !drawLabelCached(xB, yB, wB, hB, xC, yC,
+          text, fill))
+      #endif
+        TextRender_TT::drawTextOpaque(_gfx, _f, xC, yC, _label, text, fill,
+          xB, yB, wB, hB);
+    } else
+      TextRender_TT::drawText(_gfx, _f, xC, yC, _label, text, blendBg);
 
     // Also print degree symbol if enabled.
-    if (_degreeSym) {
+    if (_degreeGlyph) {
+      TextRender_TT::drawChar(_gfx, _f, xC, yC, DEGREE_SIGN_CODE_POINT, text,
+        blendBg);
+    } else if (_degreeSym) {
       // Compute coords of center of circle.
-      int16_t X = _gfx->getCursorX() + _dx_degree + _rO_degree;
-      int16_t Y = _gfx->getCursorY() + _dy_degree + _rO_degree;
-      _gfx->fillCircle(X, Y, _rO_degree, text);
-      _gfx->fillCircle(X, Y, _rI_degree, fill);
+      int16_t X = xC + _dx_degree + _rO_degree;
+      int16_t Y = yC + _dy_degree + _rO_degree;
+      Shapes_TT::fillRing(_gfx, X, Y, _rO_degree, _rI_degree, text);
     }
+    if (clipped)
+      Clip_TT::pop();
   }
 
   _changedSinceLastDrawn = false;
@@ -491,7 +653,7 @@ bool Button_TT_label::setLabelAndDrawIfChanged(const char* label,
 
   setLabel(label);
   if (_changedSinceLastDrawn || forceDraw) {
-    drawButton();
+    drawLabelChange(forceDraw);
     return (true);
   }
   return (false);
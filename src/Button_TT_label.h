@@ -68,7 +68,8 @@
 
   This class can be used to display a rectangular button (optionally with
   rounded corners) containing a text label inside it. The label can optionally
-  end with a special symbol not present in the font: a degree symbol.
+  end with a degree symbol. If the font has a glyph for the degree sign (code
+  point 0xB0), that glyph is used, else a degree symbol is drawn as a circle.
   Typical usage is similar to Button_TT class usage, with the difference that
   this class has additional initializer function arguments to support the
   additional features, such as the string giving the text for the label.
@@ -82,6 +83,34 @@
 #include <Button_TT.h>
 #include <Font_TT.h>
 
+// Set BUTTON_TT_LABEL_CACHE to 1 to let label buttons draw their labels with
+// a glyph cache (see GlyphCache_TT.h and setGlyphCache()). Each label button
+// then holds a pointer to its cache.
+#define BUTTON_TT_LABEL_CACHE 0
+
+#if BUTTON_TT_LABEL_CACHE
+#include <GlyphCache_TT.h>
+#endif
+
+// Set BUTTON_TT_BODY_REDRAW to 1 to have setLabelAndDrawIfChanged() and the
+// setValueAndDrawIfChanged() functions of the numeric buttons redraw only the
+// rows between the rounded corners of a button whose label changed, when its
+// corners are unchanged since it was last drawn. The button must then still
+// be on the screen, so after the screen is cleared those functions must be
+// called with forceDraw true. Each label button then keeps the state of its
+// corners, 8 bytes.
+#define BUTTON_TT_BODY_REDRAW 0
+
+// Maximum size in bytes of a Button_TT_label object, checked with
+// static_assert() in Button_TT_label.cpp: a Button_TT object plus three
+// pointers and 11 bytes, a pointer more for the glyph cache if
+// BUTTON_TT_LABEL_CACHE is 1, and 8 more bytes each for the corner state if
+// BUTTON_TT_BODY_REDRAW is 1 and the label rectangle if BUTTON_TT_BACKGROUND
+// is 1.
+#define BUTTON_TT_LABEL_SIZE BUTTON_TT_ROUND(BUTTON_TT_SIZE + \
+  (3 + BUTTON_TT_LABEL_CACHE) * sizeof(void*) + 11 + \
+  8 * BUTTON_TT_BODY_REDRAW + 8 * BUTTON_TT_BACKGROUND)
+
 /**************************************************************************/
 /*!
   @brief  A class that enhances class Button_TT by adding a text label inside
@@ -93,8 +122,8 @@ class Button_TT_label : public Button_TT {
 
 protected:
 
-  // Text color.
-  uint16_t _textColor;
+  // The members are ordered by size and the flags are packed into bits, as in
+  // Button_TT (see BUTTON_TT_LABEL_SIZE).
 
   // Text alignment, two characters, first is alignment in y direction (T=top,
   // B=bottom, C=center) and second is alignment in x direction (L=left,
@@ -108,12 +137,39 @@ protected:
   // user-specified label is copied.
   char* _label;
 
-  // true if label is to have a degree symbol appended to the end of it.
-  bool _degreeSym;
+  // Glyph cache used to draw the label, nullptr if none.
+  #if BUTTON_TT_LABEL_CACHE
+  GlyphCache_TT* _glyphCache;
+  #endif
 
   // Radius of rectangle corner in pixels, 0 = pure rectangle.
   int16_t _rCorner;
 
+  // State of the rounded corners when the button was last drawn, so that a
+  // label change needn't redraw them:
+  //  _cornerX, _cornerY: button position.
+  //  _cornerFill, _cornerOutline: fill and outline colors.
+  //  _cornersDrawn: true if the corners were drawn filled and the label lay
+  //                 between them.
+  //  _cornersOutlined: true if the outline was drawn with them.
+  //  _redrawBody: true if the next drawButton() call is for a label change
+  //               and may skip unchanged corners, see drawLabelChange().
+  #if BUTTON_TT_BODY_REDRAW
+  int16_t _cornerX, _cornerY;
+  uint16_t _cornerFill, _cornerOutline;
+  #endif
+
+  // Rectangle of the label when the button was last drawn, _labelW = 0 if no
+  // label was drawn. It is erased by restoring the background (if any) before
+  // the button is drawn again with a transparent fill.
+  #if BUTTON_TT_BACKGROUND
+  int16_t _labelX, _labelY;
+  uint16_t _labelW, _labelH;
+  #endif
+
+  // Text color.
+  ButtonColor_TT _textColor;
+
   // Degree symbol data:
   //  _dx_degree: distance from degree initial cursor to left of degree bound
   //              box.
@@ -123,9 +179,23 @@ protected:
   //  _d_degree: diameter of degree symbol (its width AND height).
   //  _rO_degree: outer radius of degree symbol.
   //  _rI_degree: inner radius of degree symbol.
+  //  The symbol is drawn as the ring between the two radii, see
+  //  Shapes_TT::fillRing().
   int8_t _dx_degree, _dy_degree, _xa_degree;
   uint8_t _d_degree, _rO_degree, _rI_degree;
 
+  // true if label is to have a degree symbol appended to the end of it.
+  bool _degreeSym : 1;
+
+  // true if the font has a glyph for the degree sign, which is then drawn
+  // instead of the degree symbol circle.
+  bool _degreeGlyph : 1;
+
+  // See _cornerX above.
+  #if BUTTON_TT_BODY_REDRAW
+  bool _cornersDrawn : 1, _cornersOutlined : 1, _redrawBody : 1;
+  #endif
+
   // A Font_TT object whose gfx pointer is nullptr and whose textSize values are 1.
   // The _f variable above is pointed to this when the user specifies a nullptr
   // value for the font object to be used.
@@ -176,6 +246,7 @@ protected:
   /**************************************************************************/
   // Compute degree symbol delta x/y from cursor position to upper-left corner,
   // cursor x-position advance amount, diameter, and outer and inner radius.
+  // This is used only when the font has no degree sign glyph.
   /**************************************************************************/
   void getDegreeSymSize(int8_t &dx, int8_t &dy, int8_t &xa, uint8_t &d,
       uint8_t &rO, uint8_t &rI);
@@ -190,6 +261,38 @@ protected:
   void updateLabelSizeForDegreeSymbol(int16_t dX, int16_t &dY, int16_t &dXcF,
       uint16_t &wt, uint16_t &ht);
 
+  #if BUTTON_TT_LABEL_CACHE
+  /**************************************************************************/
+  // Draw the label with its cursor starting at (xC, yC) using _glyphCache, and
+  // fill the rest of the rectangle (xI, yI, wI, hI) inside the button outline
+  // with 'fill'. (xC, yC) is advanced past the label. Returns false without
+  // drawing anything if the label's character cells don't fit inside the
+  // rectangle.
+  /**************************************************************************/
+  bool drawLabelCached(int16_t xI, int16_t yI, int16_t wI, int16_t hI,
+      int16_t &xC, int16_t &yC, uint16_t text, uint16_t fill);
+  #endif
+
+  /**************************************************************************/
+  // Draw the button after its label has changed. If BUTTON_TT_BODY_REDRAW
+  // is 1 and forceDraw is false, the button is assumed to still be on the
+  // screen, so if it has rounded corners that are unchanged since it was last
+  // drawn, only the rows between the corners are redrawn.
+  /**************************************************************************/
+  void drawLabelChange(bool forceDraw) {
+    #if BUTTON_TT_BODY_REDRAW
+    _redrawBody = !forceDraw;
+    #else
+    (void)forceDraw;
+    #endif
+    drawButton();
+  }
+
+  /**************************************************************************/
+  // Take the attributes of 'style', see Button_TT::applyStyle().
+  /**************************************************************************/
+  virtual void applyStyle(ButtonStyle_TT& style) override;
+
   /**************************************************************************/
   // public functions follow.
   /**************************************************************************/
@@ -211,7 +314,7 @@ public:
       uint16_t textColor = 0, const char* textAlign = "C", char* label = 0,
       bool degreeSym = false, Font_TT* f = nullptr, int16_t rCorner = 0,
       uint8_t expU = 0, uint8_t expD = 0, uint8_t expL = 0, uint8_t expR = 0)
-      : Button_TT(name) {
+      : Button_TT(name), _label(nullptr) {
 
     initButton(gfx, align, x, y, w, h, outlineColor, fillColor, textColor,
       textAlign, label, degreeSym, f, rCorner, expU, expD, expL, expR);
@@ -324,6 +427,29 @@ public:
   /**************************************************************************/
   bool setFont(Font_TT* f = nullptr);
 
+  #if BUTTON_TT_LABEL_CACHE
+  /**************************************************************************/
+  /*!
+    @brief    Set a glyph cache to use to draw the label of the button, or
+              nullptr to not use one. The cache can be shared by many
+              buttons. It is used for square-cornered buttons, and for
+              rounded ones whose label lies between the corners.
+    @param    cache   The glyph cache, see GlyphCache_TT.h.
+    @note     Any part of a character extending outside its character cell is
+              not drawn, see TextRender_TT::drawTextCached().
+  */
+  /**************************************************************************/
+  void setGlyphCache(GlyphCache_TT* cache) { _glyphCache = cache; }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the glyph cache used to draw the label.
+    @returns  The glyph cache, or nullptr if none.
+  */
+  /**************************************************************************/
+  GlyphCache_TT* getGlyphCache(void) { return (_glyphCache); }
+  #endif
+
   /**************************************************************************/
   /*!
     @brief    Get current button label.
@@ -335,7 +461,7 @@ public:
   /**************************************************************************/
   /*!
     @brief    Set new label for button.
-    @param    label   The new label.
+    @param    label   The new label, nullptr for none.
     @returns  true if new label is different from old label.
     @note     The new label is copied to a buffer allocated in memory for it,
               after freeing memory used by any previous label, but if the new
@@ -383,7 +509,10 @@ public:
               or if any visible button attribute changed since last drawn.
     @param    label       The new label.
     @param    forceDraw  If true, the button is drawn even if attributes have
-              not changed.
+              not changed. If BUTTON_TT_BODY_REDRAW is 1, use this after
+              clearing the screen, since without it only the part of a
+              rounded button between its corners is redrawn when the corners
+              haven't changed.
     @returns  true if button was drawn.
   */
   /**************************************************************************/
@@ -34,6 +34,10 @@
 #include <Arduino.h>
 #include <Button_TT_uint16.h>
 
+// Check that the compact layout of the members holds.
+static_assert(sizeof(Button_TT_uint16) <= BUTTON_TT_UINT16_SIZE,
+  "Button_TT_uint16 is larger than BUTTON_TT_UINT16_SIZE");
+
 /**************************************************************************/
 
 void Button_TT_uint16::initButton(
@@ -92,7 +96,7 @@ bool Button_TT_uint16::setValue(uint16_t value, bool dontCheck) {
     itoa(_value, S, 10);
     setLabel(S);
   }
-  _changedSinceLastDrawn = true;
+  setChanged();
   return (true);
 }
 
@@ -102,7 +106,7 @@ bool Button_TT_uint16::setValueAndDrawIfChanged(uint16_t value,
                                                 bool forceDraw) {
   setValue(value);
   if (_changedSinceLastDrawn || forceDraw) {
-    drawButton();
+    drawLabelChange(forceDraw);
     return (true);
   }
   return (false);
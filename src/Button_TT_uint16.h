@@ -50,6 +50,12 @@
 #include <Button_TT_label.h>
 #include <Button_TT_arrow.h>
 
+// Maximum size in bytes of a Button_TT_uint16 object, checked with
+// static_assert() in Button_TT_uint16.cpp: a Button_TT_label object plus two
+// pointers and 6 bytes.
+#define BUTTON_TT_UINT16_SIZE \
+  BUTTON_TT_ROUND(BUTTON_TT_LABEL_SIZE + 2 * sizeof(void*) + 6)
+
 /**************************************************************************/
 /*!
   @brief  A class that enhances class Button_TT_label by supplying a uint16_t
@@ -60,15 +66,15 @@ class Button_TT_uint16 : public Button_TT_label {
 
 protected:
 
-  // The current button value that is displayed, and its minimum and maximum.
-  uint16_t _value, _minValue, _maxValue;
-
   // Pointer to string to display when value is 0, nullptr to just show "0".
   const char *_zeroString;
 
   // Function to call to check if a new button value is valid.
   uint16_t (*_checkValue)(Button_TT_uint16 &btn, uint16_t value);
 
+  // The current button value that is displayed, and its minimum and maximum.
+  uint16_t _value, _minValue, _maxValue;
+
 public:
   /**************************************************************************/
   /*!
@@ -186,7 +192,8 @@ public:
               last drawn.
     @param    value       The uint16_t value for the button.
     @param    forceDraw   If true, the button is drawn even if attributes have
-                          not changed.
+                          not changed, and all of it is drawn (see
+                          Button_TT_label::setLabelAndDrawIfChanged()).
     @returns  true if button was drawn.
   */
   /**************************************************************************/
@@ -34,6 +34,10 @@
 #include <Arduino.h>
 #include <Button_TT_uint8.h>
 
+// Check that the compact layout of the members holds.
+static_assert(sizeof(Button_TT_uint8) <= BUTTON_TT_UINT8_SIZE,
+  "Button_TT_uint8 is larger than BUTTON_TT_UINT8_SIZE");
+
 /**************************************************************************/
 
 void Button_TT_uint8::initButton(
@@ -91,7 +95,7 @@ bool Button_TT_uint8::setValue(uint8_t value, bool dontCheck) {
     itoa(_value, S, 10);
     setLabel(S);
   }
-  _changedSinceLastDrawn = true;
+  setChanged();
   return (true);
 }
 
@@ -100,7 +104,7 @@ bool Button_TT_uint8::setValue(uint8_t value, bool dontCheck) {
 bool Button_TT_uint8::setValueAndDrawIfChanged(uint8_t value, bool forceDraw) {
   setValue(value);
   if (_changedSinceLastDrawn || forceDraw) {
-    drawButton();
+    drawLabelChange(forceDraw);
     return (true);
   }
   return (false);
@@ -0,0 +1,164 @@
+/*
+  Clip_TT.cpp - Defines functions of class Clip_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <Clip_TT.h>
+
+/**************************************************************************/
+int16_t Clip_TT::_stack[CLIP_TT_DEPTH][4];
+uint8_t Clip_TT::_depth = 0;
+int16_t Clip_TT::_xL = INT16_MIN;
+int16_t Clip_TT::_yT = INT16_MIN;
+int16_t Clip_TT::_xR = INT16_MAX;
+int16_t Clip_TT::_yB = INT16_MAX;
+
+/**************************************************************************/
+bool Clip_TT::push(int16_t x, int16_t y, int16_t w, int16_t h) {
+
+  if (_depth == CLIP_TT_DEPTH)
+    return (false);
+  int16_t* saved = _stack[_depth++];
+  saved[0] = _xL;
+  saved[1] = _yT;
+  saved[2] = _xR;
+  saved[3] = _yB;
+
+  // An empty intersection is kept as a rectangle with its right edge left of
+  // its left edge, or its bottom edge above its top edge.
+  int32_t xR = (int32_t)x + w - 1;
+  int32_t yB = (int32_t)y + h - 1;
+  if (x > _xL)
+    _xL = x;
+  if (y > _yT)
+    _yT = y;
+  if (xR < _xR)
+    _xR = (xR < INT16_MIN) ? INT16_MIN : xR;
+  if (yB < _yB)
+    _yB = (yB < INT16_MIN) ? INT16_MIN : yB;
+  return (true);
+}
+
+/**************************************************************************/
+void Clip_TT::pop(void) {
+
+  if (_depth == 0)
+    return;
+  const int16_t* saved = _stack[--_depth];
+  _xL = saved[0];
+  _yT = saved[1];
+  _xR = saved[2];
+  _yB = saved[3];
+}
+
+/**************************************************************************/
+bool Clip_TT::getClip(int16_t& x, int16_t& y, uint16_t& w, uint16_t& h) {
+
+  if (_depth == 0)
+    return (false);
+  x = _xL;
+  y = _yT;
+  w = (_xR >= _xL) ? (int32_t)_xR - _xL + 1 : 0;
+  h = (_yB >= _yT) ? (int32_t)_yB - _yT + 1 : 0;
+  return (true);
+}
+
+/**************************************************************************/
+bool Clip_TT::clip(int16_t& x, int16_t& y, int16_t& w, int16_t& h) {
+
+  if (rejects(x, y, w, h))
+    return (false);
+  int32_t xR = (int32_t)x + w - 1;
+  int32_t yB = (int32_t)y + h - 1;
+  if (x < _xL)
+    x = _xL;
+  if (y < _yT)
+    y = _yT;
+  if (xR > _xR)
+    xR = _xR;
+  if (yB > _yB)
+    yB = _yB;
+  w = xR - x + 1;
+  h = yB - y + 1;
+  return (true);
+}
+
+/**************************************************************************/
+void Clip_TT::writeFastVLine(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    int16_t h, uint16_t color) {
+
+  int16_t w = 1;
+  if (_depth == 0 || clip(x, y, w, h))
+    gfx->writeFastVLine(x, y, h, color);
+}
+
+/**************************************************************************/
+void Clip_TT::drawRect(Adafruit_GFX* gfx, int16_t x, int16_t y, int16_t w,
+    int16_t h, uint16_t color) {
+
+  if (_depth == 0) {
+    gfx->drawRect(x, y, w, h, color);
+    return;
+  }
+  if (rejects(x, y, w, h))
+    return;
+  gfx->startWrite();
+  writeFastHLine(gfx, x, y, w, color);
+  if (h > 1)
+    writeFastHLine(gfx, x, y + h - 1, w, color);
+  if (h > 2) {
+    writeFastVLine(gfx, x, y + 1, h - 2, color);
+    if (w > 1)
+      writeFastVLine(gfx, x + w - 1, y + 1, h - 2, color);
+  }
+  gfx->endWrite();
+}
+
+/**************************************************************************/
+void Clip_TT::drawRGBBitmap(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    uint16_t* pixels, int16_t w, int16_t h) {
+
+  if (_depth == 0) {
+    gfx->drawRGBBitmap(x, y, pixels, w, h);
+    return;
+  }
+  int16_t xC = x, yC = y, wC = w, hC = h;
+  if (!clip(xC, yC, wC, hC))
+    return;
+  pixels += (int32_t)(yC - y) * w + (xC - x);
+  if (wC == w)
+    gfx->drawRGBBitmap(xC, yC, pixels, wC, hC);
+  else
+    for (int16_t j = 0; j < hC; j++, pixels += w)
+      gfx->drawRGBBitmap(xC, yC + j, pixels, wC, 1);
+}
+
+// -------------------------------------------------------------------------
@@ -0,0 +1,332 @@
+/*
+  Clip_TT.h - Defines C++ class Clip_TT, a stack of clip rectangles that
+  limits the pixels drawn by the Button_TT library, and class ClipGFX_TT, a
+  display object that clips the drawing done on another one.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  Adafruit_GFX has no clip region; it only discards pixels that are off the
+  display. Class Clip_TT adds one. push() makes the intersection of a
+  rectangle with the current clip rectangle the new clip rectangle, and pop()
+  restores the previous one. While the stack is not empty, everything the
+  library draws (buttons, their labels and shapes, text drawn by
+  TextRender_TT, pixels restored by Popup_TT) is limited to the clip
+  rectangle. A region of the screen can then be repainted, for example after
+  a popup closes, without touching any pixel outside it.
+
+  The library draws through the static functions of Clip_TT, which have the
+  names and arguments of the Adafruit_GFX functions they replace, plus the
+  display. When the stack is empty they call the Adafruit_GFX function
+  directly. Otherwise they shorten or discard lines, rectangles, and pixel
+  rows to the clip rectangle, and the library discards glyphs and rows of
+  text that lie entirely outside it before decoding them.
+
+  For the few Adafruit_GFX drawing functions that the library calls as a
+  whole (the built-in font's drawChar(), and fillTriangle() etc. when a span
+  table can't be allocated), the library draws on a ClipGFX_TT object
+  instead, which passes the lines and pixels that those functions draw
+  through Clip_TT to the real display.
+
+  Button_TT_label clips its label (and degree symbol) to the inside of the
+  button, so a label too long for its button no longer spills out of it.
+
+  There is one clip stack for all displays. Its depth is CLIP_TT_DEPTH; a
+  push beyond that depth is ignored (it returns false) and must not be popped.
+
+  Example:
+
+    Clip_TT::push(60, 80, 200, 80);
+    drawMainScreen();
+    Clip_TT::pop();
+*/
+#ifndef Clip_TT_h
+#define Clip_TT_h
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+// Maximum depth of the clip stack.
+#define CLIP_TT_DEPTH 8
+
+/**************************************************************************/
+/*!
+  @brief  A rectangle of the screen.
+*/
+/**************************************************************************/
+typedef struct Rect_TT {
+  int16_t x, y;               // Top left corner.
+  uint16_t w, h;              // Width and height.
+} Rect_TT;
+
+/**************************************************************************/
+/*!
+  @brief  A class with a stack of clip rectangles and functions that draw
+          lines, rectangles and pixels limited to the current clip rectangle.
+*/
+/**************************************************************************/
+class Clip_TT {
+
+protected:
+
+  // Edges of the clip rectangles that were replaced by push(), each one
+  // inclusive.
+  static int16_t _stack[CLIP_TT_DEPTH][4];
+  static uint8_t _depth;
+
+  // Edges of the current clip rectangle, inclusive. When the stack is empty
+  // they are the limits of int16_t.
+  static int16_t _xL, _yT, _xR, _yB;
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Push a clip rectangle: the current clip rectangle becomes its
+              intersection with the rectangle.
+    @param    x       Left edge of the rectangle.
+    @param    y       Top edge of the rectangle.
+    @param    w       Width of the rectangle.
+    @param    h       Height of the rectangle.
+    @returns  true if pushed, false if the stack is full, in which case pop()
+              must not be called for it.
+  */
+  /**************************************************************************/
+  static bool push(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  /**************************************************************************/
+  /*!
+    @brief    Pop the clip rectangle pushed last, restoring the one before it.
+  */
+  /**************************************************************************/
+  static void pop(void);
+
+  /**************************************************************************/
+  /*!
+    @brief    Test whether drawing is being clipped.
+    @returns  true if the clip stack is not empty.
+  */
+  /**************************************************************************/
+  static bool isClipped(void) { return (_depth > 0); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the current clip rectangle.
+    @param    x       Set to its left edge.
+    @param    y       Set to its top edge.
+    @param    w       Set to its width, 0 if it is empty.
+    @param    h       Set to its height, 0 if it is empty.
+    @returns  true if the clip stack is not empty, else false and the
+              rectangle is not set.
+  */
+  /**************************************************************************/
+  static bool getClip(int16_t& x, int16_t& y, uint16_t& w, uint16_t& h);
+
+  /**************************************************************************/
+  /*!
+    @brief    Test whether a rectangle lies entirely outside the clip
+              rectangle, so nothing in it would be drawn.
+    @param    x       Left edge of the rectangle.
+    @param    y       Top edge of the rectangle.
+    @param    w       Width of the rectangle.
+    @param    h       Height of the rectangle.
+    @returns  true if no pixel of the rectangle is inside the clip rectangle,
+              which is always so when the clip rectangle is empty.
+  */
+  /**************************************************************************/
+  static bool rejects(int16_t x, int16_t y, int16_t w, int16_t h) {
+    return (_xR < _xL || _yB < _yT || w <= 0 || h <= 0 || x > _xR ||
+      y > _yB || (int32_t)x + w <= _xL || (int32_t)y + h <= _yT);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Test whether a rectangle lies entirely inside the clip
+              rectangle, so it would be drawn unchanged.
+    @param    x       Left edge of the rectangle.
+    @param    y       Top edge of the rectangle.
+    @param    w       Width of the rectangle.
+    @param    h       Height of the rectangle.
+    @returns  true if every pixel of the rectangle is inside the clip
+              rectangle.
+  */
+  /**************************************************************************/
+  static bool contains(int16_t x, int16_t y, int16_t w, int16_t h) {
+    return (x >= _xL && y >= _yT && (int32_t)x + w - 1 <= _xR &&
+      (int32_t)y + h - 1 <= _yB);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Limit a rectangle to the clip rectangle.
+    @param    x       Left edge of the rectangle, changed to that of the part
+                      inside the clip rectangle.
+    @param    y       Top edge, changed likewise.
+    @param    w       Width, changed likewise.
+    @param    h       Height, changed likewise.
+    @returns  false if no part of the rectangle is inside the clip rectangle,
+              in which case the rectangle is not changed.
+  */
+  /**************************************************************************/
+  static bool clip(int16_t& x, int16_t& y, int16_t& w, int16_t& h);
+
+  /**************************************************************************/
+  /*!
+    @brief    Adafruit_GFX::writeFastHLine(), clipped.
+  */
+  /**************************************************************************/
+  static void writeFastHLine(Adafruit_GFX* gfx, int16_t x, int16_t y,
+      int16_t w, uint16_t color) {
+    int16_t h = 1;
+    if (_depth == 0 || clip(x, y, w, h))
+      gfx->writeFastHLine(x, y, w, color);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Adafruit_GFX::writeFastVLine(), clipped.
+  */
+  /**************************************************************************/
+  static void writeFastVLine(Adafruit_GFX* gfx, int16_t x, int16_t y,
+      int16_t h, uint16_t color);
+
+  /**************************************************************************/
+  /*!
+    @brief    Adafruit_GFX::writeFillRect(), clipped.
+  */
+  /**************************************************************************/
+  static void writeFillRect(Adafruit_GFX* gfx, int16_t x, int16_t y,
+      int16_t w, int16_t h, uint16_t color) {
+    if (_depth == 0 || clip(x, y, w, h))
+      gfx->writeFillRect(x, y, w, h, color);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Adafruit_GFX::fillRect(), clipped.
+  */
+  /**************************************************************************/
+  static void fillRect(Adafruit_GFX* gfx, int16_t x, int16_t y, int16_t w,
+      int16_t h, uint16_t color) {
+    if (_depth == 0 || clip(x, y, w, h))
+      gfx->fillRect(x, y, w, h, color);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Adafruit_GFX::drawRect(), clipped.
+  */
+  /**************************************************************************/
+  static void drawRect(Adafruit_GFX* gfx, int16_t x, int16_t y, int16_t w,
+      int16_t h, uint16_t color);
+
+  /**************************************************************************/
+  /*!
+    @brief    Adafruit_GFX::drawRGBBitmap(), clipped. The rows of the part of
+              the bitmap inside the clip rectangle are drawn one at a time.
+  */
+  /**************************************************************************/
+  static void drawRGBBitmap(Adafruit_GFX* gfx, int16_t x, int16_t y,
+      uint16_t* pixels, int16_t w, int16_t h);
+};
+
+/**************************************************************************/
+/*!
+  @brief  A display object that draws on another display, limited to the
+          clip rectangle of Clip_TT, used to clip Adafruit_GFX functions that
+          the library calls as a whole.
+*/
+/**************************************************************************/
+class ClipGFX_TT : public Adafruit_GFX {
+
+protected:
+
+  Adafruit_GFX* _gfx;         // The display drawn on.
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    gfx     The display to draw on.
+  */
+  /**************************************************************************/
+  ClipGFX_TT(Adafruit_GFX* gfx) : Adafruit_GFX(gfx->width(), gfx->height()) {
+    _gfx = gfx;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Adafruit_GFX functions, passed to the display through Clip_TT.
+  */
+  /**************************************************************************/
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (Clip_TT::contains(x, y, 1, 1))
+      _gfx->drawPixel(x, y, color);
+  }
+  void startWrite(void) override { _gfx->startWrite(); }
+  void writePixel(int16_t x, int16_t y, uint16_t color) override {
+    if (Clip_TT::contains(x, y, 1, 1))
+      _gfx->writePixel(x, y, color);
+  }
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+      uint16_t color) override {
+    Clip_TT::writeFillRect(_gfx, x, y, w, h, color);
+  }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h,
+      uint16_t color) override {
+    Clip_TT::writeFastVLine(_gfx, x, y, h, color);
+  }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w,
+      uint16_t color) override {
+    Clip_TT::writeFastHLine(_gfx, x, y, w, color);
+  }
+  void endWrite(void) override { _gfx->endWrite(); }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h,
+      uint16_t color) override {
+    _gfx->startWrite();
+    Clip_TT::writeFastVLine(_gfx, x, y, h, color);
+    _gfx->endWrite();
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w,
+      uint16_t color) override {
+    _gfx->startWrite();
+    Clip_TT::writeFastHLine(_gfx, x, y, w, color);
+    _gfx->endWrite();
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+      uint16_t color) override {
+    Clip_TT::fillRect(_gfx, x, y, w, h, color);
+  }
+};
+
+#endif // Clip_TT_h
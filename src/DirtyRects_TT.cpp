@@ -0,0 +1,224 @@
+/*
+  DirtyRects_TT.cpp - Defines functions of class DirtyRects_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <Button_TT.h>
+
+// The class is compiled only if the buttons support it.
+#if BUTTON_TT_DIRTY_RECTS
+
+#include <DirtyRects_TT.h>
+
+/**************************************************************************/
+Rect_TT DirtyRects_TT::bounds(const Rect_TT& a, const Rect_TT& b) {
+
+  int32_t xL = (a.x < b.x) ? a.x : b.x;
+  int32_t yT = (a.y < b.y) ? a.y : b.y;
+  int32_t xR = ((int32_t)a.x + a.w > (int32_t)b.x + b.w) ?
+    (int32_t)a.x + a.w : (int32_t)b.x + b.w;
+  int32_t yB = ((int32_t)a.y + a.h > (int32_t)b.y + b.h) ?
+    (int32_t)a.y + a.h : (int32_t)b.y + b.h;
+  Rect_TT r;
+  r.x = xL;
+  r.y = yT;
+  r.w = (xR - xL > 0xFFFF) ? 0xFFFF : xR - xL;
+  r.h = (yB - yT > 0xFFFF) ? 0xFFFF : yB - yT;
+  return (r);
+}
+
+/**************************************************************************/
+int32_t DirtyRects_TT::waste(const Rect_TT& a, const Rect_TT& b) {
+
+  Rect_TT u = bounds(a, b);
+  int32_t area = (int32_t)u.w * u.h - (int32_t)a.w * a.h -
+    (int32_t)b.w * b.h;
+  // Add back the pixels the two have in common, counted twice above.
+  int32_t xL = (a.x > b.x) ? a.x : b.x;
+  int32_t yT = (a.y > b.y) ? a.y : b.y;
+  int32_t xR = ((int32_t)a.x + a.w < (int32_t)b.x + b.w) ?
+    (int32_t)a.x + a.w : (int32_t)b.x + b.w;
+  int32_t yB = ((int32_t)a.y + a.h < (int32_t)b.y + b.h) ?
+    (int32_t)a.y + a.h : (int32_t)b.y + b.h;
+  if (xR > xL && yB > yT)
+    area += (xR - xL) * (yB - yT);
+  return (area);
+}
+
+/**************************************************************************/
+bool DirtyRects_TT::intersects(const Rect_TT& a, const Rect_TT& b) {
+
+  return (a.x < (int32_t)b.x + b.w && b.x < (int32_t)a.x + a.w &&
+          a.y < (int32_t)b.y + b.h && b.y < (int32_t)a.y + a.h);
+}
+
+/**************************************************************************/
+void DirtyRects_TT::merge(uint8_t i, uint8_t j) {
+
+  _rects[i] = bounds(_rects[i], _rects[j]);
+  _numRects--;
+  for (; j < _numRects; j++)
+    _rects[j] = _rects[j + 1];
+}
+
+/**************************************************************************/
+void DirtyRects_TT::clear(void) {
+
+  for (uint8_t i = 0; i < _numButtons; i++)
+    _buttons[i]->setDirtyRects(nullptr);
+  _numButtons = 0;
+  _numRects = 0;
+}
+
+/**************************************************************************/
+bool DirtyRects_TT::registerButton(Button_TT& button) {
+
+  for (uint8_t i = 0; i < _numButtons; i++)
+    if (_buttons[i] == &button)
+      return (true);
+  if (_numButtons == DIRTY_RECTS_TT_MAX_BUTTONS)
+    return (false);
+  _buttons[_numButtons++] = &button;
+  button.setDirtyRects(this);
+  return (true);
+}
+
+/**************************************************************************/
+bool DirtyRects_TT::unregisterButton(Button_TT& button) {
+
+  for (uint8_t i = 0; i < _numButtons; i++) {
+    if (_buttons[i] == &button) {
+      _numButtons--;
+      for (; i < _numButtons; i++)
+        _buttons[i] = _buttons[i + 1];
+      button.setDirtyRects(nullptr);
+      return (true);
+    }
+  }
+  return (false);
+}
+
+/**************************************************************************/
+void DirtyRects_TT::addRect(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+
+  if (w == 0 || h == 0)
+    return;
+
+  // If the list is full, make room by merging the two rectangles whose
+  // merge wastes the fewest pixels.
+  if (_numRects == DIRTY_RECTS_TT_MAX_RECTS) {
+    uint8_t bi = 0, bj = 1;
+    int32_t best = waste(_rects[0], _rects[1]);
+    for (uint8_t i = 0; i < _numRects; i++)
+      for (uint8_t j = i + 1; j < _numRects; j++) {
+        int32_t c = waste(_rects[i], _rects[j]);
+        if (c < best) {
+          best = c;
+          bi = i;
+          bj = j;
+        }
+      }
+    merge(bi, bj);
+  }
+
+  Rect_TT& r = _rects[_numRects++];
+  r.x = x;
+  r.y = y;
+  r.w = w;
+  r.h = h;
+
+  // Merge the new rectangle with others while that is cheap, each merge
+  // making a larger rectangle that may in turn be cheap to merge.
+  uint8_t k = _numRects - 1;
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (uint8_t i = 0; i < _numRects; i++) {
+      if (i != k && waste(_rects[i], _rects[k]) <= DIRTY_RECTS_TT_SLACK) {
+        uint8_t lo = (i < k) ? i : k;
+        uint8_t hi = (i < k) ? k : i;
+        merge(lo, hi);
+        k = lo;
+        merged = true;
+        break;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+void DirtyRects_TT::addButton(Button_TT& button) {
+
+  int16_t x, y;
+  uint16_t w, h;
+  button.getDrawnBounds(x, y, w, h);
+  addRect(x, y, w, h);
+}
+
+/**************************************************************************/
+bool DirtyRects_TT::redraw(void) {
+
+  if (_numRects == 0)
+    return (false);
+
+  // Copy the regions and empty the list before drawing, so that nothing
+  // drawn adds to it.
+  Rect_TT rects[DIRTY_RECTS_TT_MAX_RECTS];
+  uint8_t numRects = _numRects;
+  for (uint8_t i = 0; i < numRects; i++)
+    rects[i] = _rects[i];
+  _numRects = 0;
+
+  Rect_TT drawn[DIRTY_RECTS_TT_MAX_BUTTONS];
+  for (uint8_t i = 0; i < _numButtons; i++)
+    _buttons[i]->getDrawnBounds(drawn[i].x, drawn[i].y, drawn[i].w,
+      drawn[i].h);
+
+  // Fill each region with the background, then draw the buttons that
+  // intersect it, clipped to it, so that no pixel outside the regions is
+  // drawn and a button drawn over another one is drawn after it.
+  for (uint8_t j = 0; j < numRects; j++) {
+    const Rect_TT& r = rects[j];
+    if (_drawBackground != nullptr)
+      _drawBackground(r.x, r.y, r.w, r.h);
+    bool clipped = Clip_TT::push(r.x, r.y, r.w, r.h);
+    for (uint8_t i = 0; i < _numButtons; i++)
+      if (intersects(drawn[i], r))
+        _buttons[i]->drawButton();
+    if (clipped)
+      Clip_TT::pop();
+  }
+  return (true);
+}
+
+#endif // BUTTON_TT_DIRTY_RECTS
+
+// -------------------------------------------------------------------------
@@ -0,0 +1,246 @@
+/*
+  DirtyRects_TT.h - Defines C++ class DirtyRects_TT, which collects the
+  rectangles of a screen that need to be redrawn, merges them into a few
+  regions, and redraws the buttons in those regions.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  A button only knows whether it has changed since it was last drawn, and a
+  program redraws changed buttons one by one with drawIfChanged(). That is
+  fine for buttons that don't overlap and are drawn on a plain background,
+  but it can't redraw what is under a button that moves, or buttons that
+  overlap one another.
+
+  A DirtyRects_TT object holds the buttons of a screen, registered with
+  registerButton() in the order in which they are drawn (bottom to top), and
+  a list of 'dirty' rectangles of the screen that must be redrawn. Registered
+  buttons add their drawn area to the list whenever they change (a button
+  that moves adds both its old and its new area), and the program can add any
+  other rectangle, such as a part of a button, with addRect().
+
+  As each rectangle is added, it is merged with any rectangle whose bounding
+  rectangle contains no more than DIRTY_RECTS_TT_SLACK pixels that are in
+  neither of them, so overlapping and adjacent rectangles become a single
+  region. If the list is full, the two rectangles whose merge wastes the
+  fewest pixels are merged to make room.
+
+  redraw() then repaints the regions one at a time. It calls the background
+  function given to the constructor (if any) to fill the region with the
+  screen's background, and then draws each button that intersects the region,
+  in registration order, clipped to the region with Clip_TT (see Clip_TT.h).
+  No pixel outside the regions is drawn, so a button that changes doesn't
+  cause the buttons it overlaps to be redrawn whole, and a button drawn over
+  another one is drawn after it in each region they share. A button that
+  intersects several regions is drawn once for each of them.
+
+  The buttons hold a pointer to the list they are registered with only if
+  BUTTON_TT_DIRTY_RECTS is set to 1 in Button_TT.h, which this class
+  requires.
+
+  Buttons not registered with a DirtyRects_TT object still just set their
+  changed flag, and are drawn with drawIfChanged() as before.
+
+  Example:
+
+    void fillBackground(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+      lcd->fillRect(x, y, w, h, ILI9341_BLUE);
+    }
+    DirtyRects_TT dirty(fillBackground);
+    ...
+    dirty.registerButton(btn_Temperature);
+    dirty.registerButton(btn_Alarm);
+    ...
+    btn_Temperature.setValue(temperature);
+    btn_Alarm.setPosition(x, y);
+    dirty.redraw();
+*/
+#ifndef DirtyRects_TT_h
+#define DirtyRects_TT_h
+
+#include <Arduino.h>
+#include <Button_TT.h>
+#include <Clip_TT.h>
+
+#if !BUTTON_TT_DIRTY_RECTS
+#error "DirtyRects_TT requires BUTTON_TT_DIRTY_RECTS 1 in Button_TT.h"
+#endif
+
+// Maximum number of rectangles in the list.
+#define DIRTY_RECTS_TT_MAX_RECTS 8
+
+// Maximum number of registered buttons.
+#define DIRTY_RECTS_TT_MAX_BUTTONS 20
+
+// Maximum number of pixels, in the bounding rectangle of two rectangles but
+// in neither of them, for the two to be merged into one region. This is
+// roughly the number of pixels that could be redrawn in the time it takes to
+// start drawing another region.
+#define DIRTY_RECTS_TT_SLACK 256
+
+/**************************************************************************/
+/*!
+  @brief  A class that collects the rectangles of the screen to be redrawn,
+          merges them into regions, and redraws the buttons in the regions.
+*/
+/**************************************************************************/
+class DirtyRects_TT {
+
+protected:
+
+  // Function to fill a region with the background, nullptr if none.
+  void (*_drawBackground)(int16_t x, int16_t y, uint16_t w, uint16_t h);
+
+  // The rectangles to be redrawn.
+  Rect_TT _rects[DIRTY_RECTS_TT_MAX_RECTS];
+  uint8_t _numRects;
+
+  // The registered buttons, in drawing order.
+  Button_TT* _buttons[DIRTY_RECTS_TT_MAX_BUTTONS];
+  uint8_t _numButtons;
+
+  /**************************************************************************/
+  // Return the bounding rectangle of rectangles 'a' and 'b'.
+  /**************************************************************************/
+  static Rect_TT bounds(const Rect_TT& a, const Rect_TT& b);
+
+  /**************************************************************************/
+  // Return the number of pixels in the bounding rectangle of 'a' and 'b' that
+  // are in neither of them.
+  /**************************************************************************/
+  static int32_t waste(const Rect_TT& a, const Rect_TT& b);
+
+  /**************************************************************************/
+  // Return true if rectangles 'a' and 'b' have a pixel in common.
+  /**************************************************************************/
+  static bool intersects(const Rect_TT& a, const Rect_TT& b);
+
+  /**************************************************************************/
+  // Replace rectangle i with the bounding rectangle of it and rectangle j,
+  // and remove rectangle j.
+  /**************************************************************************/
+  void merge(uint8_t i, uint8_t j);
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    drawBackground  Function to call to fill a region of the screen
+                              with the background before its buttons are
+                              redrawn, nullptr if the buttons cover the
+                              regions.
+  */
+  /**************************************************************************/
+  DirtyRects_TT(void (*drawBackground)(int16_t x, int16_t y, uint16_t w,
+      uint16_t h) = nullptr) {
+    _drawBackground = drawBackground;
+    _numRects = 0;
+    _numButtons = 0;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Unregister all buttons and empty the list of rectangles.
+  */
+  /**************************************************************************/
+  void clear(void);
+
+  /**************************************************************************/
+  /*!
+    @brief    Register a button, after the buttons already registered, so it
+              is drawn over them. The button then adds its drawn area to the
+              list whenever it changes.
+    @param    button    The button to be registered.
+    @returns  true if successful or button is already registered, false if
+              the maximum number of buttons are registered.
+  */
+  /**************************************************************************/
+  bool registerButton(Button_TT& button);
+
+  /**************************************************************************/
+  /*!
+    @brief    Unregister a previously-registered button.
+    @param    button    The button to be unregistered.
+    @returns  true if successful, false if button was not registered.
+  */
+  /**************************************************************************/
+  bool unregisterButton(Button_TT& button);
+
+  /**************************************************************************/
+  /*!
+    @brief    Add a rectangle to be redrawn.
+    @param    x       Left edge of the rectangle.
+    @param    y       Top edge of the rectangle.
+    @param    w       Width of the rectangle, nothing is added if 0.
+    @param    h       Height of the rectangle, nothing is added if 0.
+  */
+  /**************************************************************************/
+  void addRect(int16_t x, int16_t y, uint16_t w, uint16_t h);
+
+  /**************************************************************************/
+  /*!
+    @brief    Add the drawn area of a button to be redrawn.
+    @param    button    The button.
+  */
+  /**************************************************************************/
+  void addButton(Button_TT& button);
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of regions in the list.
+    @returns  Number of regions to be redrawn by redraw().
+  */
+  /**************************************************************************/
+  uint8_t getNumRects(void) { return (_numRects); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get a region in the list.
+    @param    i       Index of the region, 0..getNumRects()-1.
+    @returns  The region.
+  */
+  /**************************************************************************/
+  const Rect_TT& getRect(uint8_t i) { return (_rects[i]); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Redraw the regions in the list: fill each one with the
+              background, then draw the registered buttons in them, and empty
+              the list.
+    @returns  true if there was anything to redraw.
+  */
+  /**************************************************************************/
+  bool redraw(void);
+};
+
+#endif // DirtyRects_TT_h
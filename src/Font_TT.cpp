@@ -31,6 +31,7 @@
 */
 #include <Arduino.h>
 #include <Font_TT.h>
+#include <StreamFont_TT.h>
 #include <pgmspace_GFX.h>
 #include <glcdfont.c>
 
@@ -50,26 +51,202 @@
 #endif
 
 /**************************************************************************/
-void Font_TT::charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minX,
+Font_TT::Font_TT(const GFXfont_TT& font, uint8_t sx, uint8_t sy)
+    : extFont(&font), streamFont(nullptr), sizeX(sx), sizeY(sy) {
+
+  gfxFont = (const GFXfont*)pgm_read_pointer(&font.font);
+}
+
+/**************************************************************************/
+void Font_TT::loadFontParams(FontParams &fp) {
+
+  fp.ranges = nullptr;
+  fp.numRanges = 0;
+  fp.bitmapFormat = GFX_TT_BITMAP_RAW;
+  fp.utf8 = false;
+  fp.sx = sizeX;
+  fp.sy = sizeY;
+  fp.stream = streamFont;
+  if (streamFont) {
+    // Glyphs and their bitmaps are obtained from the streaming font.
+    fp.glyphs = nullptr;
+    fp.bitmaps = nullptr;
+    fp.bitmapFormat = streamFont->getBitmapFormat();
+    fp.utf8 = true;
+    fp.first = 0;
+    fp.last = 0;
+    fp.yAdvance = streamFont->getYAdvance();
+  } else if (gfxFont) {
+    const GFXfont* font = gfxFont;
+    if (extFont) {
+      // Use the most magnified pre-scaled variant whose magnification divides
+      // the text size, if any.
+      const GFXfont_TT* ext = extFont;
+      const GFXscaled_TT* scaled =
+        (const GFXscaled_TT*)pgm_read_pointer(&extFont->scaled);
+      uint8_t numScaled = scaled ? pgm_read_byte(&extFont->numScaled) : 0;
+      uint16_t best = 1;
+      for (uint8_t i = 0; i < numScaled; i++) {
+        uint8_t vx = pgm_read_byte(&scaled[i].sizeX);
+        uint8_t vy = pgm_read_byte(&scaled[i].sizeY);
+        if (vx > 0 && vy > 0 && sizeX % vx == 0 && sizeY % vy == 0 &&
+            vx * vy > best) {
+          best = vx * vy;
+          ext = (const GFXfont_TT*)pgm_read_pointer(&scaled[i].font);
+          fp.sx = sizeX / vx;
+          fp.sy = sizeY / vy;
+        }
+      }
+      font = (const GFXfont*)pgm_read_pointer(&ext->font);
+      fp.ranges = (const GFXrange_TT*)pgm_read_pointer(&ext->ranges);
+      fp.numRanges = pgm_read_word(&ext->numRanges);
+      fp.bitmapFormat = pgm_read_byte(&ext->bitmapFormat);
+      fp.utf8 = true;
+    }
+    fp.glyphs = pgm_read_glyph_ptr(font, 0);
+    fp.bitmaps = pgm_read_bitmap_ptr(font);
+    fp.first = pgm_read_byte(&font->first);
+    fp.last = pgm_read_byte(&font->last);
+    fp.yAdvance = pgm_read_byte(&font->yAdvance);
+  } else {
+    fp.glyphs = nullptr;
+    fp.bitmaps = nullptr;
+    fp.first = 0;
+    fp.last = 0xFF;
+    fp.yAdvance = 8;
+  }
+}
+
+/**************************************************************************/
+const GFXglyph* Font_TT::findGlyph(uint16_t c, const FontParams &fp) {
+
+  if (fp.stream)
+    return (fp.stream->findGlyph(c));
+  if (!fp.glyphs)
+    return (nullptr);
+
+  // Dense font: one range, first..last.
+  if (!fp.ranges) {
+    if (c < fp.first || c > fp.last)
+      return (nullptr);
+    return (fp.glyphs + (c - fp.first));
+  }
+
+  // Sparse font: binary search for the range containing c.
+  uint16_t lo = 0, hi = fp.numRanges;
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2;
+    const GFXrange_TT* r = fp.ranges + mid;
+    if (c < pgm_read_word(&r->first))
+      hi = mid;
+    else if (c > pgm_read_word(&r->last))
+      lo = mid + 1;
+    else
+      return (fp.glyphs + pgm_read_word(&r->glyphIndex) +
+        (c - pgm_read_word(&r->first)));
+  }
+  return (nullptr);
+}
+
+/**************************************************************************/
+uint16_t Font_TT::glyphIndex(const FontParams &fp, const GFXglyph* glyph) {
+
+  return (fp.stream ? StreamFont_TT::glyphIndex(glyph) :
+    (uint16_t)(glyph - fp.glyphs));
+}
+
+/**************************************************************************/
+const GFXglyph* Font_TT::getGlyph(uint16_t c) {
+
+  FontParams fp;
+  loadFontParams(fp);
+  return (findGlyph(c, fp));
+}
+
+/**************************************************************************/
+uint8_t Font_TT::getBitmapFormat() {
+
+  if (streamFont)
+    return (streamFont->getBitmapFormat());
+  return (extFont ? pgm_read_byte(&extFont->bitmapFormat) : GFX_TT_BITMAP_RAW);
+}
+
+/**************************************************************************/
+const uint8_t* Font_TT::getBitmaps() {
+
+  return (gfxFont ? pgm_read_bitmap_ptr(gfxFont) : nullptr);
+}
+
+/**************************************************************************/
+void Font_TT::prefetch(const char* str, bool inFlash) {
+
+  if (streamFont)
+    streamFont->prefetch(str, inFlash);
+}
+
+/**************************************************************************/
+uint16_t Font_TT::nextChar(const char*& str, bool inFlash, bool utf8) {
+
+  uint8_t c = inFlash ? pgm_read_byte(str) : (uint8_t)*str;
+  if (c == 0)
+    return (0);
+  str++;
+  if (!utf8 || c < 0x80)
+    return (c);
+
+  // Lead byte gives the number of continuation bytes that follow.
+  uint8_t n;
+  uint32_t cp;
+  if ((c & 0xE0) == 0xC0) {
+    n = 1;
+    cp = c & 0x1F;
+  } else if ((c & 0xF0) == 0xE0) {
+    n = 2;
+    cp = c & 0x0F;
+  } else if ((c & 0xF8) == 0xF0) {
+    n = 3;
+    cp = c & 0x07;
+  } else
+    return (REPLACEMENT_CODE_POINT); // Stray continuation or invalid byte.
+
+  while (n-- > 0) {
+    c = inFlash ? pgm_read_byte(str) : (uint8_t)*str;
+    if ((c & 0xC0) != 0x80)
+      return (REPLACEMENT_CODE_POINT); // Truncated, don't consume c.
+    str++;
+    cp = (cp << 6) | (c & 0x3F);
+  }
+  return ((cp > 0xFFFF) ? REPLACEMENT_CODE_POINT : (uint16_t)cp);
+}
+
+/**************************************************************************/
+void Font_TT::charBounds(uint16_t c, int16_t* x, int16_t* y, int16_t* minX,
     int16_t* minY, int16_t* maxX, int16_t* maxY) {
 
-  if (gfxFont) {
+  FontParams fp;
+  loadFontParams(fp);
+  charBounds(c, fp, x, y, minX, minY, maxX, maxY);
+}
+
+/**************************************************************************/
+void Font_TT::charBounds(uint16_t c, const FontParams &fp, int16_t* x,
+    int16_t* y, int16_t* minX, int16_t* minY, int16_t* maxX, int16_t* maxY) {
+
+  if (!builtIn(fp)) {
 
     // Custom GFX font.
     if (c == '\n') { // Newline?
       *x = 0;        // Reset x to zero, advance y by one line
-      *y += sizeY * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+      *y += fp.sy * fp.yAdvance;
     } else if (c != '\r') { // Not a carriage return; is normal char
-      uint8_t first = pgm_read_byte(&gfxFont->first),
-              last = pgm_read_byte(&gfxFont->last);
-      if ((c >= first) && (c <= last)) { // Char present in this font?
-        GFXglyph* glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+      const GFXglyph* glyph = findGlyph(c, fp);
+      if (glyph) { // Char present in this font?
         uint8_t gw = pgm_read_byte(&glyph->width),
                 gh = pgm_read_byte(&glyph->height),
                 xa = pgm_read_byte(&glyph->xAdvance);
         int8_t xo = pgm_read_byte(&glyph->xOffset),
                yo = pgm_read_byte(&glyph->yOffset);
-        int16_t tsx = (int16_t)sizeX, tsy = (int16_t)sizeY,
+        int16_t tsx = (int16_t)fp.sx, tsy = (int16_t)fp.sy,
                 x1 = *x + xo * tsx, y1 = *y + yo * tsy, x2 = x1 + gw * tsx - 1,
                 y2 = y1 + gh * tsy - 1;
         if (x1 < *minX)
@@ -108,10 +285,11 @@ void Font_TT::charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minX,
 }
 
 /**************************************************************************/
-void Font_TT::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* xL,
-    int16_t* yT, uint16_t* wt, uint16_t* ht, int16_t* xF, int16_t* yF) {
+const char* Font_TT::getTextBounds(const char* str, bool inFlash,
+    const FontParams &fp, int16_t x, int16_t y, int16_t* xL, int16_t* yT,
+    uint16_t* wt, uint16_t* ht, int16_t* xF, int16_t* yF) {
 
-  uint8_t c; // Current character
+  uint16_t c; // Current character
   int16_t minX = 0x7FFF, minY = 0x7FFF, maxX = -0x7FFF, maxY = -0x7FFF;
   // Bound rect is intentionally initialized to extremes, so 1st char sets it
 
@@ -119,10 +297,10 @@ void Font_TT::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* xL,
   *yT = y; //     is called. (Unless string is empty).
   *wt = *ht = 0; // Initial size is zero
 
-  while ((c = *str++)) {
+  while ((c = nextChar(str, inFlash, fp.utf8))) {
     // charBounds() modifies x/y to advance for each character,
     // and min/max x/y are updated to incrementally build bounding rect.
-    charBounds(c, &x, &y, &minX, &minY, &maxX, &maxY);
+    charBounds(c, fp, &x, &y, &minX, &minY, &maxX, &maxY);
   }
 
   if (maxX >= minX) { // If legit string bounds were found...
@@ -140,6 +318,18 @@ void Font_TT::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* xL,
     *xF = x;
   if (yF != nullptr)
     *yF = y;
+
+  // Skip the terminating 0.
+  return (str + 1);
+}
+
+/**************************************************************************/
+void Font_TT::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* xL,
+    int16_t* yT, uint16_t* wt, uint16_t* ht, int16_t* xF, int16_t* yF) {
+
+  FontParams fp;
+  loadFontParams(fp);
+  getTextBounds(str, false, fp, x, y, xL, yT, wt, ht, xF, yF);
 }
 
 /**************************************************************************/
@@ -157,31 +347,27 @@ void Font_TT::getTextBounds(const __FlashStringHelper* str, int16_t x,
     int16_t y, int16_t* xL, int16_t* yT, uint16_t* wt, uint16_t* ht,
     int16_t* xF, int16_t* yF) {
 
-  uint8_t* s = (uint8_t*)str, c;
-
-  *xL = x;
-  *yT = y;
-  *wt = *ht = 0;
+  FontParams fp;
+  loadFontParams(fp);
+  getTextBounds((const char*)str, true, fp, x, y, xL, yT, wt, ht, xF, yF);
+}
 
-  int16_t minX = 0x7FFF, minY = 0x7FFF, maxX = -0x7FFF, maxY = -0x7FFF;
+/**************************************************************************/
+const char* Font_TT::getTextBoundsAndOffset(const char* str, bool inFlash,
+    const FontParams &fp, TextBounds_TT &tb) {
 
-  while ((c = pgm_read_byte(s++)))
-    charBounds(c, &x, &y, &minX, &minY, &maxX, &maxY);
+  str = getTextBounds(str, inFlash, fp, 0, 0, &tb.dX, &tb.dY, &tb.wt, &tb.ht,
+    &tb.dXcF, nullptr);
 
-  if (maxX >= minX) {
-    *xL = minX;
-    *wt = maxX - minX + 1;
-  }
-  if (maxY >= minY) {
-    *yT = minY;
-    *ht = maxY - minY + 1;
-  }
+  // Add one pixel on each side of the text bounding box to account for
+  // apparent inaccuracy creeping in somewhere.
+  tb.dX -= 1;
+  tb.dY -= 1;
+  tb.wt += 2;
+  tb.ht += 2;
+  tb.dXcF += 1;
 
-  // If xF and yF arguments provided, return final cursor x and y position.
-  if (xF != nullptr)
-    *xF = x;
-  if (yF != nullptr)
-    *yF = y;
+  return (str);
 }
 
 /**************************************************************************/
@@ -223,6 +409,146 @@ void Font_TT::getTextBoundsAndOffset(const __FlashStringHelper* str,
   dXcF += 1;
 }
 
+/**************************************************************************/
+void Font_TT::getCharBoundsAndOffset(uint16_t c, TextBounds_TT &tb) {
+
+  FontParams fp;
+  loadFontParams(fp);
+  int16_t x = 0, y = 0;
+  int16_t minX = 0x7FFF, minY = 0x7FFF, maxX = -0x7FFF, maxY = -0x7FFF;
+  charBounds(c, fp, &x, &y, &minX, &minY, &maxX, &maxY);
+
+  tb.dX = tb.dY = 0;
+  tb.wt = tb.ht = 0;
+  if (maxX >= minX) {
+    tb.dX = minX;
+    tb.wt = maxX - minX + 1;
+  }
+  if (maxY >= minY) {
+    tb.dY = minY;
+    tb.ht = maxY - minY + 1;
+  }
+  tb.dXcF = x;
+
+  // Same adjustment as getTextBoundsAndOffset().
+  tb.dX -= 1;
+  tb.dY -= 1;
+  tb.wt += 2;
+  tb.ht += 2;
+  tb.dXcF += 1;
+}
+
+/**************************************************************************/
+void Font_TT::getTextBoundsAndOffset(const char* const strs[], uint16_t N,
+    TextBounds_TT tb[]) {
+
+  FontParams fp;
+  loadFontParams(fp);
+  for (uint16_t i = 0; i < N; i++)
+    getTextBoundsAndOffset(strs[i], false, fp, tb[i]);
+}
+
+/**************************************************************************/
+void Font_TT::getPackedTextBoundsAndOffset(const char* packed, uint16_t N,
+    TextBounds_TT tb[], bool inFlash) {
+
+  FontParams fp;
+  loadFontParams(fp);
+  for (uint16_t i = 0; i < N; i++)
+    packed = getTextBoundsAndOffset(packed, inFlash, fp, tb[i]);
+}
+
+/**************************************************************************/
+uint16_t Font_TT::getMaxTextSize(const char* const strs[], uint16_t N,
+    uint16_t &wMax, uint16_t &hMax) {
+
+  FontParams fp;
+  loadFontParams(fp);
+  TextBounds_TT tb;
+  uint16_t iMax = 0;
+  wMax = hMax = 0;
+  for (uint16_t i = 0; i < N; i++) {
+    getTextBoundsAndOffset(strs[i], false, fp, tb);
+    if (tb.wt > wMax) {
+      wMax = tb.wt;
+      iMax = i;
+    }
+    if (tb.ht > hMax)
+      hMax = tb.ht;
+  }
+  return (iMax);
+}
+
+/**************************************************************************/
+uint16_t Font_TT::getPackedMaxTextSize(const char* packed, uint16_t N,
+    uint16_t &wMax, uint16_t &hMax, bool inFlash) {
+
+  FontParams fp;
+  loadFontParams(fp);
+  TextBounds_TT tb;
+  uint16_t iMax = 0;
+  wMax = hMax = 0;
+  for (uint16_t i = 0; i < N; i++) {
+    packed = getTextBoundsAndOffset(packed, inFlash, fp, tb);
+    if (tb.wt > wMax) {
+      wMax = tb.wt;
+      iMax = i;
+    }
+    if (tb.ht > hMax)
+      hMax = tb.ht;
+  }
+  return (iMax);
+}
+
+/**************************************************************************/
+void Font_TT::getFontExtent(int16_t &dY, uint16_t &ht) {
+
+  FontParams fp;
+  loadFontParams(fp);
+  if (builtIn(fp)) {
+    dY = 0;
+    ht = 8 * fp.sy;
+    return;
+  }
+
+  // A streaming font stores its extent in its font file.
+  if (fp.stream) {
+    int16_t yT, yB;
+    fp.stream->getExtent(yT, yB);
+    dY = yT * fp.sy;
+    ht = (yB - yT) * fp.sy;
+    return;
+  }
+
+  // Number of glyphs in the glyph array.
+  uint16_t N = fp.last - fp.first + 1;
+  if (fp.ranges) {
+    N = 0;
+    for (uint16_t i = 0; i < fp.numRanges; i++) {
+      const GFXrange_TT* r = &fp.ranges[i];
+      uint16_t n = pgm_read_word(&r->glyphIndex) +
+        pgm_read_word(&r->last) - pgm_read_word(&r->first) + 1;
+      if (n > N)
+        N = n;
+    }
+  }
+
+  int16_t yT = 0, yB = 0;
+  for (uint16_t i = 0; i < N; i++) {
+    const GFXglyph* glyph = &fp.glyphs[i];
+    uint8_t h = pgm_read_byte(&glyph->height);
+    if (h == 0)
+      continue;
+    int8_t yo = pgm_read_byte(&glyph->yOffset);
+    if (yo < yT)
+      yT = yo;
+    if (yo + h > yB)
+      yB = yo + h;
+  }
+  dY = yT * fp.sy;
+  ht = (yB - yT) * fp.sy;
+}
+
 /**************************************************************************/
 void Font_TT::newTextBoundsAndOffset(int16_t dX, int16_t dY, uint16_t wt,
     uint16_t ht, int16_t dXcF, int16_t dX2, int16_t dY2, uint16_t wt2,
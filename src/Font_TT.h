@@ -42,6 +42,11 @@
 
   This class also supports the Adafruit classic built-in fixed-space font.
 
+  This class also supports GFXfont_TT fonts (see GFXfont_TT.h), whose
+  characters are a sparse set of Unicode code point ranges. Strings measured
+  with a GFXfont_TT font are decoded as UTF-8. Such fonts can't be drawn by
+  Adafruit_GFX::print(); use TextRender_TT to draw them.
+
   Text wrapping is not supported.
 
   In an ideal world this class would have been used by class Adafruit_GFX, since
@@ -53,6 +58,24 @@
 
 #include <Arduino.h>
 #include <gfxfont.h>
+#include <GFXfont_TT.h>
+
+class StreamFont_TT;
+
+/**************************************************************************/
+/*!
+  @brief  Bounding box size and cursor offsets of one text string, as returned
+          by Font_TT::getTextBoundsAndOffset(). The multi-string measuring
+          functions of Font_TT return an array of these, one per string.
+*/
+/**************************************************************************/
+typedef struct {
+  int16_t dX;     // Delta x from left side of string to starting cursor x.
+  int16_t dY;     // Delta y from top side of string to starting cursor y.
+  uint16_t wt;    // String bounding rectangle width in pixels.
+  uint16_t ht;    // String bounding rectangle height in pixels.
+  int16_t dXcF;   // Delta x from starting to ending cursor position.
+} TextBounds_TT;
 
 /**************************************************************************/
 /*!
@@ -62,11 +85,98 @@
 /**************************************************************************/
 class Font_TT {
 
+  // TextRender_TT uses the protected font access functions to draw text.
+  friend class TextRender_TT;
+
 protected:
   const GFXfont* gfxFont; // Pointer to font struct to attach to the class instance.
+  const GFXfont_TT* extFont; // Pointer to extended font struct, else nullptr.
+  StreamFont_TT* streamFont; // Pointer to streaming font, else nullptr.
   uint8_t sizeX;    // Desired magnification in X-axis of font characters.
   uint8_t sizeY;    // Desired magnification in Y-axis of font characters.
 
+  // Font values that are needed for every character measured, read from the
+  // GFXfont struct (which may be in PROGMEM) once per string or once per set
+  // of strings, rather than once per character.
+  typedef struct {
+    const GFXglyph* glyphs;     // Glyph array, nullptr for built-in font.
+    const uint8_t* bitmaps;     // Glyph bitmaps, nullptr for built-in font.
+    StreamFont_TT* stream;      // Streaming font, whose glyphs and bitmaps
+                                // are read from it, else nullptr.
+    const GFXrange_TT* ranges;  // Code point ranges, nullptr if dense font.
+    uint16_t numRanges;         // Number of entries in ranges[].
+    uint16_t first;             // First character in a dense font.
+    uint16_t last;              // Last character in a dense font.
+    uint8_t yAdvance;           // Newline distance in y-direction.
+    uint8_t bitmapFormat;       // GFX_TT_BITMAP_* format of the bitmaps.
+    bool utf8;                  // true if strings are decoded as UTF-8.
+    uint8_t sx, sy;             // Magnification to apply to the glyphs.
+  } FontParams;
+
+  /**********************************************************************/
+  // Read the font values needed for measuring text into 'fp'. If the font
+  // has a pre-scaled variant for the current text size, the variant's values
+  // are read instead, with 'sx' and 'sy' set to the magnification remaining
+  // to be applied to it.
+  /**********************************************************************/
+  void loadFontParams(FontParams &fp);
+
+  /**********************************************************************/
+  // Return a pointer to the glyph for code point c, or nullptr if the font
+  // has no glyph for c or is the built-in font. 'fp' must have been set by
+  // loadFontParams(). Sparse fonts are searched with a binary search of their
+  // range table.
+  /**********************************************************************/
+  static const GFXglyph* findGlyph(uint16_t c, const FontParams &fp);
+
+  /**********************************************************************/
+  // Return true if 'fp' is the built-in font.
+  /**********************************************************************/
+  static bool builtIn(const FontParams &fp) {
+    return (fp.glyphs == nullptr && fp.stream == nullptr);
+  }
+
+  /**********************************************************************/
+  // Return the pointer to which a glyph's bitmapOffset is added to get its
+  // bitmap. A streaming font's glyph is followed by its bitmap in RAM.
+  /**********************************************************************/
+  static const uint8_t* glyphBitmaps(const FontParams &fp,
+      const GFXglyph* glyph) {
+    return (fp.stream ? (const uint8_t*)(glyph + 1) : fp.bitmaps);
+  }
+
+  /**********************************************************************/
+  // Return an index of a glyph that, together with the font's glyph array
+  // or streaming font, identifies the glyph.
+  /**********************************************************************/
+  static uint16_t glyphIndex(const FontParams &fp, const GFXglyph* glyph);
+
+  /**********************************************************************/
+  // Same as public function charBounds() below, except that the font values
+  // are taken from 'fp', which must have been set by loadFontParams().
+  /**********************************************************************/
+  void charBounds(uint16_t c, const FontParams &fp, int16_t* x, int16_t* y,
+    int16_t* minX, int16_t* minY, int16_t* maxX, int16_t* maxY);
+
+  /**********************************************************************/
+  // Same as public function getTextBounds() below, except that the font
+  // values are taken from 'fp', which must have been set by loadFontParams(),
+  // and 'str' is a PROGMEM string if 'inFlash' is true. Returns a pointer to
+  // the character following the string's terminating 0.
+  /**********************************************************************/
+  const char* getTextBounds(const char* str, bool inFlash,
+    const FontParams &fp, int16_t x, int16_t y, int16_t* xL, int16_t* yT,
+    uint16_t* wt, uint16_t* ht, int16_t* xF, int16_t* yF);
+
+  /**********************************************************************/
+  // Same as public function getTextBoundsAndOffset() below, except that the
+  // font values are taken from 'fp', 'str' is a PROGMEM string if 'inFlash'
+  // is true, and the results are returned in 'tb'. Returns a pointer to the
+  // character following the string's terminating 0.
+  /**********************************************************************/
+  const char* getTextBoundsAndOffset(const char* str, bool inFlash,
+    const FontParams &fp, TextBounds_TT &tb);
+
 public:
 
   /**********************************************************************/
@@ -79,7 +189,33 @@ public:
   */
   /**********************************************************************/
   Font_TT(const GFXfont* font, uint8_t sx, uint8_t sy)
-      : gfxFont(font), sizeX(sx), sizeY(sy) {}
+      : gfxFont(font), extFont(nullptr), streamFont(nullptr), sizeX(sx),
+        sizeY(sy) {}
+
+  /**********************************************************************/
+  /*!
+    @brief  Constructor for a font with sparse code point ranges.
+    @param  font  Reference to GFXfont_TT font struct to attach to the class
+                  instance.
+    @param  sx    Desired text width magnification in X direction.
+    @param  sy    Desired text width magnification in Y direction.
+  */
+  /**********************************************************************/
+  Font_TT(const GFXfont_TT& font, uint8_t sx = 1, uint8_t sy = 1);
+
+  /**********************************************************************/
+  /*!
+    @brief  Constructor for a font read from external storage.
+    @param  font  Reference to the StreamFont_TT font to attach to the class
+                  instance. Its begin() function must have been called
+                  successfully before the font is used.
+    @param  sx    Desired text width magnification in X direction.
+    @param  sy    Desired text width magnification in Y direction.
+  */
+  /**********************************************************************/
+  Font_TT(StreamFont_TT& font, uint8_t sx = 1, uint8_t sy = 1)
+      : gfxFont(nullptr), extFont(nullptr), streamFont(&font), sizeX(sx),
+        sizeY(sy) {}
 
   /**********************************************************************/
   /*!
@@ -105,8 +241,9 @@ public:
   */
   /**********************************************************************/
   bool operator == (const Font_TT& other) const {
-    return(gfxFont == other.gfxFont &&
-      sizeX == other.sizeX && sizeY == other.sizeY);
+    return(gfxFont == other.gfxFont && extFont == other.extFont &&
+      streamFont == other.streamFont && sizeX == other.sizeX &&
+      sizeY == other.sizeY);
     }
 
   /**********************************************************************/
@@ -125,7 +262,7 @@ public:
     @brief    Get the font attached to this Font_TT class instance.
     @returns  The GFXfont pointer of the font attached to this class instance,
               or nullptr if this class instance uses the built-in fixed-space
-              font.
+              font or a streaming font.
     @note   The font attached to the class instance is fixed by the constructor
             and can't be changed on the fly. Create a different class instance
             to use a different font.
@@ -133,6 +270,91 @@ public:
   /**********************************************************************/
   const GFXfont* getFont() { return(gfxFont); }
 
+  /**********************************************************************/
+  /*!
+    @brief    Get the extended font attached to this Font_TT class instance.
+    @returns  The GFXfont_TT pointer of the font attached to this class
+              instance, or nullptr if the font is a standard GFXfont font or
+              the built-in font.
+  */
+  /**********************************************************************/
+  const GFXfont_TT* getExtFont() { return(extFont); }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the streaming font attached to this Font_TT class instance.
+    @returns  The StreamFont_TT pointer of the font attached to this class
+              instance, or nullptr if the font is not a streaming font.
+  */
+  /**********************************************************************/
+  StreamFont_TT* getStreamFont() { return(streamFont); }
+
+  /**********************************************************************/
+  /*!
+    @brief    Read the glyphs of all characters of a string into the cache of
+              a streaming font (see StreamFont_TT::prefetch()). Does nothing
+              for other fonts.
+    @param    str       The string.
+    @param    inFlash   true if the string is in PROGMEM.
+  */
+  /**********************************************************************/
+  void prefetch(const char* str, bool inFlash = false);
+
+  /**********************************************************************/
+  /*!
+    @brief    Query whether strings are decoded as UTF-8 by this font.
+    @returns  true if the font is a GFXfont_TT or StreamFont_TT font, whose
+              strings are UTF-8.
+  */
+  /**********************************************************************/
+  bool isUTF8() { return(extFont != nullptr || streamFont != nullptr); }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the glyph for a character.
+    @param    c   The character code, or Unicode code point for a GFXfont_TT
+                  font.
+    @returns  Pointer to the glyph (which may be in PROGMEM), or nullptr if
+              the font has no glyph for c or is the built-in font. The glyph
+              of a streaming font is valid only until its next glyph lookup.
+  */
+  /**********************************************************************/
+  const GFXglyph* getGlyph(uint16_t c);
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the format of the font's glyph bitmaps.
+    @returns  GFX_TT_BITMAP_RAW for standard GFXfont bitmaps and for the
+              built-in font, else the bitmapFormat of the GFXfont_TT font.
+  */
+  /**********************************************************************/
+  uint8_t getBitmapFormat();
+
+  /**********************************************************************/
+  /*!
+    @brief    Get a pointer to the start of the font's glyph bitmaps.
+    @returns  Pointer to the bitmaps (which may be in PROGMEM), or nullptr for
+              the built-in font and streaming fonts.
+  */
+  /**********************************************************************/
+  const uint8_t* getBitmaps();
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the next character of a string and advance the string
+              pointer past it.
+    @param    str     Reference to the string pointer, advanced past the
+                      character on return, but not past a terminating 0.
+    @param    inFlash true if the string is in PROGMEM.
+    @param    utf8    true to decode a UTF-8 sequence, else each byte is one
+                      character.
+    @returns  The character code or code point, 0 at the end of the string.
+              Malformed UTF-8 sequences and code points above 0xFFFF return
+              REPLACEMENT_CODE_POINT.
+  */
+  /**********************************************************************/
+  static uint16_t nextChar(const char*& str, bool inFlash, bool utf8);
+
   /**********************************************************************/
   /*!
     @brief    Get text 'magnification' size in X direction.
@@ -186,7 +408,8 @@ public:
             pixels and its offset from a starting drawing position of (x,y).
             The actual first pixel is written at (x+minX, y+minY) and the last
             pixel is written at (x+maxX, y+maxY).
-    @param  c     The ASCII character in question, or a newline ('\n').
+    @param  c     The ASCII character in question, or a newline ('\n'). For a
+                  GFXfont_TT font this is the Unicode code point.
     @param  x     Pointer to helper variable for this function, that accumulates
                   size in the X-direction. On call it contains an initial X
                   size, and on return it has been adjusted by adding to it the X
@@ -225,7 +448,7 @@ public:
                   initialize this to -0x7FFF.
   */
   /**********************************************************************/
-  void charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minX,
+  void charBounds(uint16_t c, int16_t* x, int16_t* y, int16_t* minX,
     int16_t* minY, int16_t* maxX, int16_t* maxY);
 
   /**********************************************************************/
@@ -377,6 +600,96 @@ public:
   void getTextBoundsAndOffset(const __FlashStringHelper* str, int16_t &dX,
     int16_t &dY, uint16_t &wt, uint16_t &ht, int16_t &dXcF);
 
+  /**********************************************************************/
+  /*!
+    @brief      Compute the bounding box size and cursor offset of a single
+                character, as getTextBoundsAndOffset() would for a string
+                containing only that character.
+    @param  c   The character code, or Unicode code point for a GFXfont_TT
+                font.
+    @param  tb  Struct to receive the character size and cursor offsets.
+  */
+  /**********************************************************************/
+  void getCharBoundsAndOffset(uint16_t c, TextBounds_TT &tb);
+
+  /**********************************************************************/
+  /*!
+    @brief        Compute the string bounding box size and cursor offset of
+                  each string of an array of strings, using current text size
+                  and the font attached to the class instance. The results are
+                  the same as calling getTextBoundsAndOffset() once for each
+                  string, but the font values needed for the measurement are
+                  read only once for the entire set of strings.
+    @param  strs  Array of N pointers to the ASCII strings to measure.
+    @param  N     Number of strings in strs[].
+    @param  tb    Array of N structs to receive the size and cursor offsets of
+                  the strings, tb[i] corresponding to strs[i]. See
+                  getTextBoundsAndOffset() for a description of each member.
+  */
+  /**********************************************************************/
+  void getTextBoundsAndOffset(const char* const strs[], uint16_t N,
+    TextBounds_TT tb[]);
+
+  /**********************************************************************/
+  /*!
+    @brief          Like getTextBoundsAndOffset() above except the strings are
+                    packed one after the other into a single character array,
+                    each terminated by a 0 character, e.g. "ON\0OFF\0AUTO".
+    @param  packed  The packed string table containing N strings.
+    @param  N       Number of strings in the packed string table.
+    @param  tb      Array of N structs to receive the string sizes and offsets.
+    @param  inFlash true if 'packed' is in PROGMEM (e.g. created with PSTR()).
+  */
+  /**********************************************************************/
+  void getPackedTextBoundsAndOffset(const char* packed, uint16_t N,
+    TextBounds_TT tb[], bool inFlash = false);
+
+  /**********************************************************************/
+  /*!
+    @brief        Compute the maximum width and height of a set of strings, as
+                  would be returned by getTextBoundsAndOffset() for each one.
+                  This is useful for giving a uniform size to a group of
+                  buttons, such as the keys of a keypad.
+    @param  strs  Array of N pointers to the ASCII strings to measure.
+    @param  N     Number of strings in strs[].
+    @param  wMax  Reference to variable to receive the maximum string width.
+    @param  hMax  Reference to variable to receive the maximum string height.
+    @returns      Index of the widest string, or 0 if N is 0.
+  */
+  /**********************************************************************/
+  uint16_t getMaxTextSize(const char* const strs[], uint16_t N,
+    uint16_t &wMax, uint16_t &hMax);
+
+  /**********************************************************************/
+  /*!
+    @brief          Like getMaxTextSize() above except the strings are in a
+                    packed string table, see getPackedTextBoundsAndOffset().
+    @param  packed  The packed string table containing N strings.
+    @param  N       Number of strings in the packed string table.
+    @param  wMax    Reference to variable to receive the maximum string width.
+    @param  hMax    Reference to variable to receive the maximum string height.
+    @param  inFlash true if 'packed' is in PROGMEM (e.g. created with PSTR()).
+    @returns        Index of the widest string, or 0 if N is 0.
+  */
+  /**********************************************************************/
+  uint16_t getPackedMaxTextSize(const char* packed, uint16_t N,
+    uint16_t &wMax, uint16_t &hMax, bool inFlash = false);
+
+  /**********************************************************************/
+  /*!
+    @brief        Compute the vertical extent of the font, the smallest band
+                  containing every glyph of the font, using current text size.
+    @param  dY    Reference to variable to receive the delta y from the cursor
+                  y (the baseline) to the top of the band, usually negative.
+                  For the built-in font this is 0, since its cursor is at the
+                  top of the character.
+    @param  ht    Reference to variable to receive the height of the band.
+    @note   Each glyph of the font is examined, so save the result rather
+            than calling this for each string drawn.
+  */
+  /**********************************************************************/
+  void getFontExtent(int16_t &dY, uint16_t &ht);
+
   /**********************************************************************/
   /*!
     @brief          Compute new values dYnew, wt_new, ht_new, and dXcFnew that
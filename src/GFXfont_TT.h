@@ -0,0 +1,191 @@
+/*
+  GFXfont_TT.h - Defines struct GFXfont_TT, an extension of the Adafruit_GFX
+  GFXfont struct, for fonts whose characters are not one dense range of 8-bit
+  character codes.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  A standard GFXfont covers the single range of character codes first..last,
+  with one GFXglyph entry for every code in that range. A font that needs a few
+  characters far from the others (e.g. the degree sign 0xB0, micro sign 0xB5,
+  or arrows 0x2190-0x2193 in addition to ASCII) must either carry empty glyphs
+  for every code in between or be split into several fonts.
+
+  A GFXfont_TT instead pairs a GFXfont holding the glyph array, bitmaps, and
+  yAdvance, with a table of code point ranges. Each range maps the code points
+  first..last to consecutive entries of the glyph array, starting at
+  glyphIndex. The ranges must be sorted by increasing code point and must not
+  overlap, so that a glyph is found with a binary search of the range table.
+  The first and last members of the GFXfont are used only if ranges is nullptr,
+  see below.
+
+  Code points are Unicode values up to 0xFFFF. Strings measured or drawn using
+  a GFXfont_TT font are decoded as UTF-8, so the degree symbol is written in a
+  string as "\xC2\xB0" (or simply as the character itself if the source file is
+  UTF-8 encoded).
+
+  The glyph bitmaps may be stored in one of these formats, given by the
+  bitmapFormat member:
+
+    GFX_TT_BITMAP_RAW: the standard GFXfont format, 1 bit per pixel, rows
+      packed one after the other with no padding, each glyph starting on a
+      byte boundary, most significant bit first.
+
+    GFX_TT_BITMAP_RLE: row run-length encoding, where each glyph is a sequence
+      of row records, one for each row or group of identical rows. A row record
+      starts with a byte N:
+        N < 0x80: the row contains N horizontal spans of set pixels, given by
+          N pairs of bytes (skip, len) that follow. 'skip' is the number of
+          clear pixels before the span, counted from the start of the row for
+          the first span and from the end of the previous span otherwise, and
+          'len' is the number of set pixels in the span.
+        N >= 0x80: the previous row is repeated N-0x7F more times. Several
+          repeat records may follow one another, for more than 128 repeats.
+      Large glyphs (e.g. big digits) compress well since a vertical stroke
+      becomes one record for many rows, and they also draw fast, since each
+      span of identical rows is drawn as a single filled rectangle.
+
+    GFX_TT_BITMAP_GRAY2, GFX_TT_BITMAP_GRAY4: anti-aliased glyphs with 2 or 4
+      bits per pixel, packed like GFX_TT_BITMAP_RAW (rows one after the other
+      with no padding, each glyph starting on a byte boundary, most
+      significant bits first). Each pixel is a coverage level from 0 (not
+      covered, background) to 3 or 15 (fully covered, text color). Text is
+      drawn by blending the text color with a known background color, such as
+      the fill color of a button, using a small table of the 4 or 16 blended
+      colors, so each pixel is a table lookup. Where no background color is
+      known, pixels at least half covered are drawn in the text color.
+      Glyph metrics are the same as for 1-bit glyphs, so text is measured in
+      the same way.
+
+  Use tools/gfxfont_compress.py to convert a GFXfont header file to a
+  GFXfont_TT font with RLE bitmaps, and tools/gfxfont_antialias.py to create a
+  GFXfont_TT font with GRAY2 or GRAY4 bitmaps from a larger GFXfont.
+
+  If ranges is nullptr, the font has the single dense range font->first..
+  font->last, which is useful for a compressed font with no sparse ranges.
+
+  A font may also list pre-scaled variants of itself in its 'scaled' table.
+  Each variant is a complete GFXfont_TT font whose glyphs have been magnified
+  ahead of time (and optionally smoothed) by tools/gfxfont_scale.py. When a
+  Font_TT object's text size is a multiple of a variant's magnification, the
+  variant is drawn instead of magnifying each pixel of the font at run time,
+  and any remaining magnification is applied to the variant. Text measures the
+  same either way. Fonts without variants may omit the last two members.
+
+  All tables may be placed in PROGMEM.
+
+  Example:
+
+    const GFXrange_TT MyFontRanges[] PROGMEM = {
+      { 0x0020, 0x007E, 0 },    // ASCII, glyphs 0..94
+      { 0x00B0, 0x00B0, 95 },   // Degree sign, glyph 95
+      { 0x00B5, 0x00B5, 96 },   // Micro sign, glyph 96
+      { 0x2190, 0x2193, 97 }    // Arrows, glyphs 97..100
+    };
+    const GFXfont_TT MyFont PROGMEM = {
+      &MyFontGFX, MyFontRanges, 4, GFX_TT_BITMAP_RAW
+    };
+
+  Example with pre-scaled variants, as written by tools/gfxfont_scale.py:
+
+    const GFXscaled_TT BigDigitsScaled[] PROGMEM = {
+      { 2, 2, &BigDigits_x2 },
+      { 3, 3, &BigDigits_x3 }
+    };
+    const GFXfont_TT BigDigits PROGMEM = {
+      &BigDigitsGFX, BigDigitsRanges, 1, GFX_TT_BITMAP_RLE, BigDigitsScaled, 2
+    };
+*/
+#ifndef GFXfont_TT_h
+#define GFXfont_TT_h
+
+#include <Arduino.h>
+#include <gfxfont.h>
+
+// Code point of the degree sign, drawn by Button_TT_label using the font glyph
+// if the font has one.
+#define DEGREE_SIGN_CODE_POINT 0x00B0
+
+// Code point used in place of a malformed UTF-8 sequence.
+#define REPLACEMENT_CODE_POINT 0xFFFD
+
+// Glyph bitmap formats of a GFXfont_TT font, see above.
+#define GFX_TT_BITMAP_RAW 0
+#define GFX_TT_BITMAP_RLE 1
+#define GFX_TT_BITMAP_GRAY2 2
+#define GFX_TT_BITMAP_GRAY4 3
+
+// Bit set in the first byte of an RLE row record that repeats the previous row.
+#define GFX_TT_RLE_REPEAT 0x80
+
+/**************************************************************************/
+/*!
+  @brief  A range of consecutive code points whose glyphs are stored
+          consecutively in a font's glyph array.
+*/
+/**************************************************************************/
+typedef struct {
+  uint16_t first;       // First code point in the range.
+  uint16_t last;        // Last code point in the range.
+  uint16_t glyphIndex;  // Index in glyph array of the glyph for 'first'.
+} GFXrange_TT;
+
+struct GFXscaled_TT;
+
+/**************************************************************************/
+/*!
+  @brief  A font whose characters are a sparse set of code point ranges.
+*/
+/**************************************************************************/
+typedef struct GFXfont_TT {
+  const GFXfont* font;        // Glyphs, bitmaps, and yAdvance of the font.
+  const GFXrange_TT* ranges;  // Code point ranges, sorted by code point.
+  uint16_t numRanges;         // Number of entries in ranges[].
+  uint8_t bitmapFormat;       // GFX_TT_BITMAP_* format of the bitmaps.
+  const struct GFXscaled_TT* scaled;  // Pre-scaled variants, or nullptr.
+  uint8_t numScaled;          // Number of entries in scaled[].
+} GFXfont_TT;
+
+/**************************************************************************/
+/*!
+  @brief  A pre-scaled variant of a font, drawn in place of the font when it
+          is magnified by a multiple of sizeX and sizeY.
+*/
+/**************************************************************************/
+typedef struct GFXscaled_TT {
+  uint8_t sizeX;              // Magnification in x-direction of the variant.
+  uint8_t sizeY;              // Magnification in y-direction of the variant.
+  const GFXfont_TT* font;     // The pre-scaled font.
+} GFXscaled_TT;
+
+#endif // GFXfont_TT_h
@@ -0,0 +1,150 @@
+/*
+  GlyphCache_TT.cpp - Defines functions of class GlyphCache_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <GlyphCache_TT.h>
+
+/**************************************************************************/
+GlyphCache_TT::GlyphCache_TT(size_t budget) {
+  _head = nullptr;
+  _budget = budget;
+  _used = 0;
+  _hits = 0;
+  _misses = 0;
+  _extFont = nullptr;
+  _extSizeX = _extSizeY = 0;
+  _extDY = 0;
+  _extHt = 0;
+}
+
+/**************************************************************************/
+void GlyphCache_TT::evict(size_t bytes) {
+  while (_head != nullptr && _used + bytes > _budget) {
+    // Remove the last entry in the list, the least recently used one.
+    Entry_TT** pp = &_head;
+    while ((*pp)->next != nullptr)
+      pp = &(*pp)->next;
+    _used -= entrySize((*pp)->w, (*pp)->h);
+    free(*pp);
+    *pp = nullptr;
+  }
+}
+
+/**************************************************************************/
+void GlyphCache_TT::clear(void) {
+  while (_head != nullptr) {
+    Entry_TT* e = _head;
+    _head = e->next;
+    free(e);
+  }
+  _used = 0;
+}
+
+/**************************************************************************/
+void GlyphCache_TT::setBudget(size_t budget) {
+  _budget = budget;
+  evict(0);
+}
+
+/**************************************************************************/
+GlyphCachePixel_TT* GlyphCache_TT::find(const void* font, uint16_t index,
+    uint8_t sx, uint8_t sy, uint16_t fg, uint16_t bg, int16_t w, int16_t h) {
+
+  #if GLYPH_CACHE_TT_INDEXED
+  (void)fg;
+  (void)bg;
+  #endif
+  Entry_TT** pp = &_head;
+  for (Entry_TT* e = _head; e != nullptr; pp = &e->next, e = e->next) {
+    if (e->font == font && e->index == index &&
+        #if !GLYPH_CACHE_TT_INDEXED
+        e->fg == fg && e->bg == bg &&
+        #endif
+        e->sx == sx && e->sy == sy && e->w == w && e->h == h) {
+      // Move the entry to the front of the list.
+      *pp = e->next;
+      e->next = _head;
+      _head = e;
+      _hits++;
+      return ((GlyphCachePixel_TT*)(e + 1));
+    }
+  }
+  _misses++;
+  return (nullptr);
+}
+
+/**************************************************************************/
+GlyphCachePixel_TT* GlyphCache_TT::add(const void* font, uint16_t index,
+    uint8_t sx, uint8_t sy, uint16_t fg, uint16_t bg, int16_t w, int16_t h) {
+
+  size_t bytes = entrySize(w, h);
+  if (w <= 0 || h <= 0 || bytes > _budget)
+    return (nullptr);
+  evict(bytes);
+  Entry_TT* e = (Entry_TT*)malloc(bytes);
+  if (e == nullptr)
+    return (nullptr);
+  e->font = font;
+  e->index = index;
+  #if GLYPH_CACHE_TT_INDEXED
+  (void)fg;
+  (void)bg;
+  #else
+  e->fg = fg;
+  e->bg = bg;
+  #endif
+  e->sx = sx;
+  e->sy = sy;
+  e->w = w;
+  e->h = h;
+  e->next = _head;
+  _head = e;
+  _used += bytes;
+  return ((GlyphCachePixel_TT*)(e + 1));
+}
+
+/**************************************************************************/
+void GlyphCache_TT::getFontExtent(Font_TT* f, int16_t &dY, uint16_t &ht) {
+  const void* font = f->getFont() ? (const void*)f->getFont() :
+    (const void*)f->getStreamFont();
+  if (_extFont == nullptr || _extFont != font ||
+      _extSizeX != f->getTextSizeX() || _extSizeY != f->getTextSizeY()) {
+    f->getFontExtent(_extDY, _extHt);
+    _extFont = font;
+    _extSizeX = f->getTextSizeX();
+    _extSizeY = f->getTextSizeY();
+  }
+  dY = _extDY;
+  ht = _extHt;
+}
+
+// -------------------------------------------------------------------------
@@ -0,0 +1,269 @@
+/*
+  GlyphCache_TT.h - Defines C++ class GlyphCache_TT, a cache of font glyphs that
+  have been expanded into blocks of RGB565 pixels, used by TextRender_TT to
+  quickly redraw frequently drawn characters.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  Numeric readouts redraw the same few characters (usually the ten digits) in
+  the same colors over and over. Drawing a character normally means decoding
+  its glyph bitmap bit by bit and sending each run of pixels to the display as
+  a separate operation. A GlyphCache_TT instead keeps the finished pixels of
+  each recently drawn character cell, so redrawing the character is a single
+  block write to the display (one address window and one bulk pixel write on
+  an Adafruit_SPITFT display).
+
+  A cache entry is the RGB565 pixel block of one character cell: the glyph's
+  advance width wide and the font's full height high (see
+  Font_TT::getFontExtent()), with the glyph in the foreground color and the
+  rest of the cell in the background color. Entries are keyed by the font and
+  the index of the glyph in it (see Font_TT::glyphIndex()), the magnification,
+  and the two colors. The glyph pointer itself is not used as the key, since
+  a streaming font's glyphs (see StreamFont_TT.h) move about in RAM.
+
+  The cache holds at most 'budget' bytes of entries, including a small header
+  per entry. When adding an entry would exceed the budget, the least recently
+  used entries are discarded. A cell of a 16x24 pixel glyph takes 768 bytes,
+  so this is really only suitable for processors with plenty of RAM.
+
+  Set GLYPH_CACHE_TT_INDEXED to 1 to halve that. An entry then holds one byte
+  per pixel, the pixel's coverage level (0 for the background, 1 for the
+  foreground of a 1-bit font, up to 3 or 15 for a fully covered pixel of an
+  anti-aliased font), and each row is expanded to RGB565 pixels through a
+  table of the blended colors as it is written to the display. The colors are
+  no longer part of the key, so one entry serves a character in any colors.
+  Cells wider than GLYPH_CACHE_TT_MAX_WIDTH pixels are then not cached.
+
+  The cache is used by calling TextRender_TT::drawTextCached(), or by giving it
+  to a Button_TT_label with setGlyphCache(), which requires
+  BUTTON_TT_LABEL_CACHE to be 1 (see Button_TT_label.h).
+
+  Example:
+
+    GlyphCache_TT glyphCache(16384);
+    ...
+    TextRender_TT::drawTextCached(gfx, &font, &glyphCache, x, y, "123",
+      ILI9341_WHITE, ILI9341_BLACK);
+*/
+#ifndef GlyphCache_TT_h
+#define GlyphCache_TT_h
+
+#include <Arduino.h>
+#include <Font_TT.h>
+
+// Set this to 1 to keep the coverage level of each pixel of a cache entry in
+// one byte, rather than its RGB565 color in two.
+#define GLYPH_CACHE_TT_INDEXED 0
+
+// Widest cell cached when GLYPH_CACHE_TT_INDEXED is 1. A row of RGB565 pixels
+// this wide is kept on the stack while drawing a cell.
+#define GLYPH_CACHE_TT_MAX_WIDTH 80
+
+// Type of the pixels of a cache entry.
+#if GLYPH_CACHE_TT_INDEXED
+typedef uint8_t GlyphCachePixel_TT;
+#else
+typedef uint16_t GlyphCachePixel_TT;
+#endif
+
+/**************************************************************************/
+/*!
+  @brief  A least-recently-used cache of character cells expanded to RGB565
+          pixels or coverage levels.
+*/
+/**************************************************************************/
+class GlyphCache_TT {
+
+protected:
+
+  // A cache entry. The entry's w*h pixels follow it in memory.
+  typedef struct Entry_TT {
+    struct Entry_TT* next;    // Next entry, in order of most recent use.
+    const void* font;         // Glyph array or StreamFont_TT of the font.
+    uint16_t index;           // Index of the glyph of the character.
+    #if !GLYPH_CACHE_TT_INDEXED
+    uint16_t fg;              // Foreground (glyph) color.
+    uint16_t bg;              // Background color.
+    #endif
+    uint8_t sx;               // Magnification in x-direction.
+    uint8_t sy;               // Magnification in y-direction.
+    int16_t w;                // Width of pixel block.
+    int16_t h;                // Height of pixel block.
+  } Entry_TT;
+
+  Entry_TT* _head;            // Most recently used entry, nullptr if empty.
+  size_t _budget;             // Maximum bytes used by entries.
+  size_t _used;               // Bytes currently used by entries.
+  uint32_t _hits;             // Number of find() calls that found the entry.
+  uint32_t _misses;           // Number of find() calls that didn't.
+
+  // Font extent saved by getFontExtent(), and the font and text size it is
+  // for. Both sizes are kept, since the pre-scaled variant of the font that
+  // is used depends on both.
+  const void* _extFont;
+  uint8_t _extSizeX, _extSizeY;
+  int16_t _extDY;
+  uint16_t _extHt;
+
+  /**************************************************************************/
+  // Return the number of bytes used by an entry with a w x h pixel block.
+  /**************************************************************************/
+  static size_t entrySize(int16_t w, int16_t h) {
+    return (sizeof(Entry_TT) + (size_t)w * h * sizeof(GlyphCachePixel_TT));
+  }
+
+  /**************************************************************************/
+  // Discard least recently used entries until 'bytes' more bytes fit in the
+  // budget.
+  /**************************************************************************/
+  void evict(size_t bytes);
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    budget  Maximum number of bytes of RAM to use for cache entries.
+  */
+  /**************************************************************************/
+  GlyphCache_TT(size_t budget);
+
+  /**************************************************************************/
+  /*!
+    @brief    Destructor. Release memory used by cache entries.
+  */
+  /**************************************************************************/
+  ~GlyphCache_TT() { clear(); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Discard all cache entries.
+  */
+  /**************************************************************************/
+  void clear(void);
+
+  /**************************************************************************/
+  /*!
+    @brief    Change the cache budget, discarding least recently used entries
+              if necessary to fit within the new budget.
+    @param    budget  Maximum number of bytes of RAM to use for cache entries.
+  */
+  /**************************************************************************/
+  void setBudget(size_t budget);
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the cache budget.
+    @returns  The maximum number of bytes of RAM used for cache entries.
+  */
+  /**************************************************************************/
+  size_t getBudget(void) { return (_budget); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of bytes of RAM currently used by cache entries.
+    @returns  The number of bytes used.
+  */
+  /**************************************************************************/
+  size_t getUsed(void) { return (_used); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of find() calls that found the requested entry.
+    @returns  The number of cache hits.
+  */
+  /**************************************************************************/
+  uint32_t getHits(void) { return (_hits); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of find() calls that didn't find the requested
+              entry.
+    @returns  The number of cache misses.
+  */
+  /**************************************************************************/
+  uint32_t getMisses(void) { return (_misses); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Find a cache entry and mark it as most recently used.
+    @param    font    The font's glyph array, or its StreamFont_TT.
+    @param    index   Index of the glyph of the character in the font.
+    @param    sx      Magnification in x-direction.
+    @param    sy      Magnification in y-direction.
+    @param    fg      Foreground color, ignored if GLYPH_CACHE_TT_INDEXED.
+    @param    bg      Background color, ignored if GLYPH_CACHE_TT_INDEXED.
+    @param    w       Width of the character cell.
+    @param    h       Height of the character cell.
+    @returns  Pointer to the entry's w*h pixels, or nullptr if not found.
+  */
+  /**************************************************************************/
+  GlyphCachePixel_TT* find(const void* font, uint16_t index, uint8_t sx,
+    uint8_t sy, uint16_t fg, uint16_t bg, int16_t w, int16_t h);
+
+  /**************************************************************************/
+  /*!
+    @brief    Add a cache entry as the most recently used entry, discarding
+              least recently used entries if necessary to make room. The caller
+              must fill in the entry's pixels.
+    @param    font    The font's glyph array, or its StreamFont_TT.
+    @param    index   Index of the glyph of the character in the font.
+    @param    sx      Magnification in x-direction.
+    @param    sy      Magnification in y-direction.
+    @param    fg      Foreground color, ignored if GLYPH_CACHE_TT_INDEXED.
+    @param    bg      Background color, ignored if GLYPH_CACHE_TT_INDEXED.
+    @param    w       Width of the character cell.
+    @param    h       Height of the character cell.
+    @returns  Pointer to the entry's w*h pixels, rows from top to bottom, or
+              nullptr if the entry is larger than the budget or memory could
+              not be allocated.
+  */
+  /**************************************************************************/
+  GlyphCachePixel_TT* add(const void* font, uint16_t index, uint8_t sx,
+    uint8_t sy, uint16_t fg, uint16_t bg, int16_t w, int16_t h);
+
+  /**************************************************************************/
+  /*!
+    @brief    Same as Font_TT::getFontExtent(), but the result for the most
+              recently used font and size is saved so that repeated calls are
+              fast.
+    @param    f       The font object.
+    @param    dY      Reference to variable to receive the delta y from the
+                      cursor y to the top of the font's band.
+    @param    ht      Reference to variable to receive the height of the band.
+  */
+  /**************************************************************************/
+  void getFontExtent(Font_TT* f, int16_t &dY, uint16_t &ht);
+};
+
+#endif // GlyphCache_TT_h
@@ -0,0 +1,106 @@
+/*
+  Palette_TT.cpp - Defines functions of class Palette_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <Palette_TT.h>
+
+/**************************************************************************/
+uint16_t Palette_TT::_colors[PALETTE_TT_SIZE];
+uint16_t Palette_TT::_size = 0;
+uint16_t Palette_TT::_lastColor;
+uint16_t Palette_TT::_lastN = 0;
+uint8_t Palette_TT::_lastIndex;
+
+/**************************************************************************/
+void Palette_TT::set(uint8_t index, uint16_t color) {
+  _colors[index] = color;
+  if (index >= _size)
+    _size = index + 1;
+  _lastN = 0;
+}
+
+/**************************************************************************/
+void Palette_TT::set(const uint16_t* colors, uint16_t n, uint8_t first) {
+  for (uint16_t i = 0; i < n && first + i < PALETTE_TT_SIZE; i++)
+    set(first + i, colors[i]);
+}
+
+/**************************************************************************/
+uint8_t Palette_TT::index(uint16_t color, uint16_t n) {
+
+  if (n > _size)
+    n = _size;
+  if (n == _lastN && color == _lastColor)
+    return (_lastIndex);
+
+  // Search for the color, keeping the nearest one by the sum of the squared
+  // differences of the 5-6-5 components (green halved to 5 bits).
+  uint8_t best = 0;
+  uint16_t bestD = 0xFFFF;
+  int8_t r = color >> 11, g = (color >> 6) & 0x1F, b = color & 0x1F;
+  for (uint16_t i = 0; i < n; i++) {
+    uint16_t c = _colors[i];
+    if (c == color) {
+      best = i;
+      break;
+    }
+    int8_t dr = r - (c >> 11), dg = g - ((c >> 6) & 0x1F), db = b - (c & 0x1F);
+    uint16_t d = dr * dr + dg * dg + db * db;
+    if (d < bestD) {
+      bestD = d;
+      best = i;
+    }
+  }
+  _lastColor = color;
+  _lastN = n;
+  _lastIndex = best;
+  return (best);
+}
+
+/**************************************************************************/
+void Palette_TT::expand8(const uint8_t* indices, uint16_t* pixels, int16_t n) {
+  for (int16_t i = 0; i < n; i++)
+    pixels[i] = _colors[indices[i]];
+}
+
+/**************************************************************************/
+void Palette_TT::expand4(const uint8_t* indices, uint16_t* pixels, int16_t n) {
+  int16_t i = 0;
+  for (; i + 1 < n; i += 2, indices++) {
+    pixels[i] = _colors[*indices >> 4];
+    pixels[i + 1] = _colors[*indices & 0x0F];
+  }
+  if (i < n)
+    pixels[i] = _colors[*indices >> 4];
+}
+
+// -------------------------------------------------------------------------
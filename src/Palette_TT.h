@@ -0,0 +1,178 @@
+/*
+  Palette_TT.h - Defines C++ class Palette_TT, a table of up to 256 RGB565
+  colors that buttons and strip buffers refer to by index.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  An RGB565 color takes two bytes. A screen rarely uses more than a few dozen
+  distinct colors, so a color can instead be kept as a one-byte index into a
+  table of the colors in use, or as a 4-bit index if there are no more than
+  16, and expanded to RGB565 by table lookup when it is finally written to the
+  display.
+
+  Class Palette_TT holds that table. It is static, one palette for the whole
+  program. Its entries are set with set(), and color() looks an index up.
+  Entries that are never set are black.
+
+  The palette is used by:
+
+    - Buttons, when BUTTON_TT_PALETTE is 1 (see Button_TT.h). Each color of a
+      button is then a one-byte palette index, expanded each time the button
+      is drawn, so changing the color of a palette entry and redrawing the
+      screen changes every button using that entry: a theme swap is a
+      palette update.
+
+    - StripRender_TT, when STRIP_RENDER_TT_BITS is 8 or 4 (see
+      StripRender_TT.h). Its strip buffer then holds palette indices, a half or
+      a quarter of the size of an RGB565 buffer, expanded a row at a time as
+      the strip is written to the display.
+
+  Anything drawn into an indexed strip buffer is an RGB565 color that must be
+  turned back into an index. index() does that, returning the index of the
+  entry with that color or, if there is none, of the entry with the nearest
+  color, so the colors drawn (including the blended edge colors of
+  anti-aliased text, if the result is to look right) should be in the palette.
+  The last color looked up is remembered, so successive lookups of the same
+  color are fast.
+
+  Example:
+
+    enum { BLACK, WHITE, ACCENT };
+    Palette_TT::set(BLACK, ILI9341_BLACK);
+    Palette_TT::set(WHITE, ILI9341_WHITE);
+    Palette_TT::set(ACCENT, ILI9341_BLUE);
+    ...
+    // Switch to the dark-red theme.
+    Palette_TT::set(ACCENT, ILI9341_MAROON);
+    redrawScreen();
+*/
+#ifndef Palette_TT_h
+#define Palette_TT_h
+
+#include <Arduino.h>
+
+// Number of palette entries.
+#define PALETTE_TT_SIZE 256
+
+/**************************************************************************/
+/*!
+  @brief  A static table of RGB565 colors indexed by palette indices.
+*/
+/**************************************************************************/
+class Palette_TT {
+
+protected:
+
+  static uint16_t _colors[PALETTE_TT_SIZE]; // The palette.
+  static uint16_t _size;      // 1 + highest index that has been set.
+
+  // The last color looked up by index(), the number of entries searched, and
+  // the index found. _lastN is 0 if there is none.
+  static uint16_t _lastColor;
+  static uint16_t _lastN;
+  static uint8_t _lastIndex;
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the color of a palette entry.
+    @param    index   Index of the entry.
+    @param    color   Its RGB565 color.
+  */
+  /**************************************************************************/
+  static void set(uint8_t index, uint16_t color);
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the colors of consecutive palette entries.
+    @param    colors  Array of n RGB565 colors.
+    @param    n       Number of colors.
+    @param    first   Index of the entry to receive colors[0].
+  */
+  /**************************************************************************/
+  static void set(const uint16_t* colors, uint16_t n, uint8_t first = 0);
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the color of a palette entry.
+    @param    index   Index of the entry.
+    @returns  Its RGB565 color.
+  */
+  /**************************************************************************/
+  static uint16_t color(uint8_t index) { return (_colors[index]); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of palette entries in use.
+    @returns  1 + the highest index that has been set, 0 if none.
+  */
+  /**************************************************************************/
+  static uint16_t size(void) { return (_size); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Find the palette entry with a color, or failing that the one
+              with the nearest color.
+    @param    color   The RGB565 color.
+    @param    n       Number of entries to search, starting with entry 0, for
+                      example 16 for a 4-bit index. Entries beyond size() are
+                      not searched.
+    @returns  The index of the entry, 0 if no entries are searched.
+  */
+  /**************************************************************************/
+  static uint8_t index(uint16_t color, uint16_t n = PALETTE_TT_SIZE);
+
+  /**************************************************************************/
+  /*!
+    @brief    Expand a row of 8-bit palette indices to RGB565 colors.
+    @param    indices The n indices.
+    @param    pixels  Array to receive the n colors.
+    @param    n       Number of pixels.
+  */
+  /**************************************************************************/
+  static void expand8(const uint8_t* indices, uint16_t* pixels, int16_t n);
+
+  /**************************************************************************/
+  /*!
+    @brief    Expand a row of 4-bit palette indices, two per byte with the
+              first pixel in the high 4 bits, to RGB565 colors.
+    @param    indices The (n+1)/2 bytes of indices.
+    @param    pixels  Array to receive the n colors.
+    @param    n       Number of pixels.
+  */
+  /**************************************************************************/
+  static void expand4(const uint8_t* indices, uint16_t* pixels, int16_t n);
+};
+
+#endif // Palette_TT_h
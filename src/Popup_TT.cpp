@@ -0,0 +1,169 @@
+/*
+  Popup_TT.cpp - Defines functions of class Popup_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <Popup_TT.h>
+
+/**************************************************************************/
+// Draw the w x h block of RGB565 pixels 'pixels' at (x,y), which lies on the
+// display, limited to the clip rectangle.
+/**************************************************************************/
+static void drawPixels(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    uint16_t* pixels, int16_t w, int16_t h) {
+
+  #if TEXT_RENDER_TT_SPITFT
+  if (TextRender_TT::windowable(gfx, x, y, w, h)) {
+    ((Adafruit_SPITFT*)gfx)->drawRGBBitmap(x, y, pixels, w, h);
+    return;
+  }
+  #endif
+  Clip_TT::drawRGBBitmap(gfx, x, y, pixels, w, h);
+}
+
+/**************************************************************************/
+bool Popup_TT::save(void) {
+
+  if (_reader == nullptr || _w == 0 || _h == 0)
+    return (false);
+  uint32_t n = (uint32_t)_w * _h;
+
+  if (_store == nullptr) {
+    if (n > ((size_t)-1) / sizeof(uint16_t))
+      return (false);
+    _buffer = (uint16_t*)malloc(n * sizeof(uint16_t));
+    if (_buffer == nullptr)
+      return (false);
+    for (uint16_t j = 0; j < _h; j++) {
+      if (!_reader->readPixels(_x, _y + j, _w, _buffer + (uint32_t)j * _w)) {
+        free(_buffer);
+        _buffer = nullptr;
+        return (false);
+      }
+    }
+    return (true);
+  }
+
+  if (_store->capacity() < n)
+    return (false);
+  uint16_t pixels[POPUP_TT_CHUNK];
+  uint32_t index = 0;
+  for (uint16_t j = 0; j < _h; j++) {
+    for (uint16_t i = 0; i < _w; i += POPUP_TT_CHUNK) {
+      uint16_t k = _w - i;
+      if (k > POPUP_TT_CHUNK)
+        k = POPUP_TT_CHUNK;
+      if (!_reader->readPixels(_x + i, _y + j, k, pixels) ||
+          !_store->write(index, pixels, k))
+        return (false);
+      index += k;
+    }
+  }
+  return (true);
+}
+
+/**************************************************************************/
+bool Popup_TT::restore(void) {
+
+  if (_buffer != nullptr) {
+    drawPixels(_gfx, _x, _y, _buffer, _w, _h);
+    return (true);
+  }
+
+  // Read the store a chunk at a time, outside any display transaction.
+  uint16_t pixels[POPUP_TT_CHUNK];
+  uint32_t index = 0;
+  for (uint16_t j = 0; j < _h; j++) {
+    for (uint16_t i = 0; i < _w; i += POPUP_TT_CHUNK) {
+      uint16_t k = _w - i;
+      if (k > POPUP_TT_CHUNK)
+        k = POPUP_TT_CHUNK;
+      if (!_store->read(index, pixels, k))
+        return (false);
+      drawPixels(_gfx, _x + i, _y + j, pixels, k, 1);
+      index += k;
+    }
+  }
+  return (true);
+}
+
+/**************************************************************************/
+bool Popup_TT::open(Adafruit_GFX* gfx, int16_t x, int16_t y, uint16_t w,
+    uint16_t h, Button_TT_collection*& active) {
+
+  if (_open)
+    return (false);
+
+  // Release any pressed button so that it is saved in its released state.
+  if (active != nullptr)
+    active->release();
+
+  // Limit the rectangle to the display.
+  int32_t xR = (int32_t)x + w;
+  int32_t yB = (int32_t)y + h;
+  if (x < 0)
+    x = 0;
+  if (y < 0)
+    y = 0;
+  if (xR > gfx->width())
+    xR = gfx->width();
+  if (yB > gfx->height())
+    yB = gfx->height();
+  _gfx = gfx;
+  _x = x;
+  _y = y;
+  _w = (xR > x) ? xR - x : 0;
+  _h = (yB > y) ? yB - y : 0;
+  _saved = save();
+
+  _active = &active;
+  _prior = active;
+  active = &_buttons;
+  _open = true;
+  return (_saved);
+}
+
+/**************************************************************************/
+bool Popup_TT::close(void) {
+
+  if (!_open)
+    return (false);
+  _buttons.release();
+  bool restored = _saved && restore();
+  free(_buffer);
+  _buffer = nullptr;
+  _saved = false;
+  *_active = _prior;
+  _open = false;
+  return (restored);
+}
+
+// -------------------------------------------------------------------------
@@ -0,0 +1,334 @@
+/*
+  Popup_TT.h - Defines C++ class Popup_TT, a popup (dialog, confirmation,
+  numeric keypad, etc.) drawn over part of a screen, which saves the pixels it
+  covers and restores them when it closes, and classes ScreenReader_TT and
+  PixelStore_TT, the interfaces it uses to read the display and to keep the
+  saved pixels.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  Without Popup_TT, closing a popup means redrawing the whole screen under it,
+  button by button. A Popup_TT object instead reads the rectangle that the
+  popup will cover before it is drawn, and writes the saved pixels back when
+  the popup closes, as a single bitmap write.
+
+  Adafruit_GFX has no way to read pixels back from a display, so they are read
+  through a ScreenReader_TT object, whose single function readPixels() reads
+  part of a row of the display. Derive a class from it for a display whose
+  memory can be read. Class CanvasReader_TT reads a GFXcanvas16, for programs
+  that draw to an off-screen canvas, and for testing.
+
+  The saved pixels are kept in a RAM buffer allocated from the heap when the
+  popup opens and freed when it closes, 2 bytes per pixel, which suits hosts
+  and processors with plenty of RAM. On a small processor, pass a
+  PixelStore_TT object to the constructor instead, to keep the pixels
+  elsewhere, such as in an SPI SRAM chip. Pixels then pass through a buffer of
+  POPUP_TT_CHUNK pixels on the stack. If the pixels can't be saved (no reader,
+  the RAM can't be allocated, or the store is too small), the popup still
+  opens, and close() returns false to say that the screen under it must be
+  redrawn.
+
+  A popup has its own Button_TT_collection, returned by getButtons(), in which
+  to register the popup's buttons. open() makes it the active collection by
+  setting the program's pointer to the active collection (e.g. the
+  'screenButtons' pointer of the README examples) to it, and close() sets the
+  pointer back to the collection that was active before. Before saving the
+  screen, open() releases any pressed button of the collection that was
+  active, so that the button is saved (and later restored) in its released
+  state. Popups can be nested, each one saving the pixels under it, as long as
+  they are closed in the reverse order in which they were opened.
+
+  If all displays are derived from class Adafruit_SPITFT (see
+  TEXT_RENDER_TT_SPITFT in TextRender_TT.h), pixels saved in RAM are restored
+  through a single address window, and pixels in a PixelStore_TT through one
+  window per chunk, each chunk being read before the window is opened, since
+  the store and the display may share an SPI bus.
+
+  Example:
+
+    CanvasReader_TT reader(&canvas);
+    Popup_TT confirm(&reader);
+    ...
+    confirm.getButtons().registerButton(btn_Yes, btnTap_Yes);
+    confirm.getButtons().registerButton(btn_No, btnTap_No);
+    ...
+    confirm.open(lcd, 60, 80, 200, 80, screenButtons);
+    lcd->fillRect(60, 80, 200, 80, ILI9341_LIGHTGREY);
+    btn_Yes.drawButton();
+    btn_No.drawButton();
+    ...
+    if (!confirm.close())
+      drawMainScreen();
+*/
+#ifndef Popup_TT_h
+#define Popup_TT_h
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Button_TT_collection.h>
+#include <TextRender_TT.h>
+
+// Number of pixels moved at a time between the display and a PixelStore_TT,
+// through a buffer on the stack.
+#define POPUP_TT_CHUNK 32
+
+/**************************************************************************/
+/*!
+  @brief  Interface for reading pixels from a display.
+*/
+/**************************************************************************/
+class ScreenReader_TT {
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Destructor.
+  */
+  /**************************************************************************/
+  virtual ~ScreenReader_TT() {}
+
+  /**************************************************************************/
+  /*!
+    @brief    Read part of a row of display pixels.
+    @param    x       X-coordinate of the first pixel to read.
+    @param    y       Y-coordinate of the row.
+    @param    w       Number of pixels to read, which all lie on the display.
+    @param    pixels  Buffer to receive the RGB565 pixels.
+    @returns  true if all w pixels were read.
+  */
+  /**************************************************************************/
+  virtual bool readPixels(int16_t x, int16_t y, uint16_t w,
+    uint16_t* pixels) = 0;
+};
+
+/**************************************************************************/
+/*!
+  @brief  A ScreenReader_TT that reads the pixels of a GFXcanvas16.
+*/
+/**************************************************************************/
+class CanvasReader_TT : public ScreenReader_TT {
+
+protected:
+
+  GFXcanvas16* _canvas;       // The canvas to read.
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    canvas  The canvas to read.
+  */
+  /**************************************************************************/
+  CanvasReader_TT(GFXcanvas16* canvas) { _canvas = canvas; }
+
+  /**************************************************************************/
+  /*!
+    @brief    Read part of a row of the canvas, see
+              ScreenReader_TT::readPixels().
+  */
+  /**************************************************************************/
+  bool readPixels(int16_t x, int16_t y, uint16_t w, uint16_t* pixels) {
+    for (uint16_t i = 0; i < w; i++)
+      pixels[i] = _canvas->getPixel(x + i, y);
+    return (true);
+  }
+};
+
+/**************************************************************************/
+/*!
+  @brief  Interface for storage that holds the pixels saved by a popup.
+*/
+/**************************************************************************/
+class PixelStore_TT {
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Destructor.
+  */
+  /**************************************************************************/
+  virtual ~PixelStore_TT() {}
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the size of the store.
+    @returns  The number of pixels the store can hold.
+  */
+  /**************************************************************************/
+  virtual uint32_t capacity(void) = 0;
+
+  /**************************************************************************/
+  /*!
+    @brief    Write pixels to the store.
+    @param    index   Index in the store of the first pixel to write.
+    @param    pixels  The RGB565 pixels to write.
+    @param    n       Number of pixels to write.
+    @returns  true if all n pixels were written.
+  */
+  /**************************************************************************/
+  virtual bool write(uint32_t index, const uint16_t* pixels, uint16_t n) = 0;
+
+  /**************************************************************************/
+  /*!
+    @brief    Read pixels from the store.
+    @param    index   Index in the store of the first pixel to read.
+    @param    pixels  Buffer to receive the RGB565 pixels.
+    @param    n       Number of pixels to read.
+    @returns  true if all n pixels were read.
+  */
+  /**************************************************************************/
+  virtual bool read(uint32_t index, uint16_t* pixels, uint16_t n) = 0;
+};
+
+/**************************************************************************/
+/*!
+  @brief  A popup that saves the pixels under it when it opens and restores
+          them when it closes, and that has its own button collection.
+*/
+/**************************************************************************/
+class Popup_TT {
+
+protected:
+
+  ScreenReader_TT* _reader;   // Reader of the display, nullptr if none.
+  PixelStore_TT* _store;      // Store of the saved pixels, nullptr for RAM.
+  uint16_t* _buffer;          // RAM buffer of the saved pixels, else nullptr.
+  Adafruit_GFX* _gfx;         // Display the popup is open on.
+  int16_t _x, _y;             // Top left of the saved rectangle.
+  uint16_t _w, _h;            // Size of the saved rectangle.
+  bool _open;                 // true while the popup is open.
+  bool _saved;                // true if the pixels under it were saved.
+
+  // The popup's buttons.
+  Button_TT_collection _buttons;
+
+  // Pointer to the active collection, and the collection that was active
+  // before the popup opened.
+  Button_TT_collection** _active;
+  Button_TT_collection* _prior;
+
+  /**************************************************************************/
+  // Save the pixels of the rectangle _x, _y, _w, _h. Returns true if saved.
+  /**************************************************************************/
+  bool save(void);
+
+  /**************************************************************************/
+  // Write the saved pixels back to the display. Returns true if restored.
+  /**************************************************************************/
+  bool restore(void);
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    reader  Reader of the display pixels, nullptr if they can't be
+                      read (close() then always returns false).
+    @param    store   Store for the saved pixels, nullptr to save them in a RAM
+                      buffer allocated from the heap.
+  */
+  /**************************************************************************/
+  Popup_TT(ScreenReader_TT* reader, PixelStore_TT* store = nullptr) {
+    _reader = reader;
+    _store = store;
+    _buffer = nullptr;
+    _gfx = nullptr;
+    _x = _y = 0;
+    _w = _h = 0;
+    _open = false;
+    _saved = false;
+    _active = nullptr;
+    _prior = nullptr;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Destructor. Free the RAM buffer if the popup is still open.
+  */
+  /**************************************************************************/
+  ~Popup_TT() { free(_buffer); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the popup's button collection, in which to register the
+              buttons that are drawn in the popup.
+    @returns  Reference to the collection.
+  */
+  /**************************************************************************/
+  Button_TT_collection& getButtons(void) { return (_buttons); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Open the popup: release any pressed button of the active
+              collection, save the pixels of the rectangle that the popup
+              will cover, and make the popup's collection the active one. Then
+              draw the popup.
+    @param    gfx     The display.
+    @param    x       Left edge of the popup.
+    @param    y       Top edge of the popup.
+    @param    w       Width of the popup.
+    @param    h       Height of the popup.
+    @param    active  The program's pointer to the active button collection,
+                      which is set to the popup's collection.
+    @returns  true if the pixels under the popup were saved, false if not or
+              if the popup was already open.
+  */
+  /**************************************************************************/
+  bool open(Adafruit_GFX* gfx, int16_t x, int16_t y, uint16_t w, uint16_t h,
+    Button_TT_collection*& active);
+
+  /**************************************************************************/
+  /*!
+    @brief    Close the popup: release any pressed popup button, write the
+              saved pixels back, and make the collection that was active when
+              the popup opened the active one again.
+    @returns  true if the screen under the popup was restored, false if it
+              was not (the pixels were not saved, or could not be read back)
+              and must be redrawn by the caller, or the popup was not open.
+  */
+  /**************************************************************************/
+  bool close(void);
+
+  /**************************************************************************/
+  /*!
+    @brief    Test whether the popup is open.
+    @returns  true if open() has been called and close() has not.
+  */
+  /**************************************************************************/
+  bool isOpen(void) { return (_open); }
+};
+
+#endif // Popup_TT_h
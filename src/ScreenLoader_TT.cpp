@@ -0,0 +1,240 @@
+/*
+  ScreenLoader_TT.cpp - Defines functions of class ScreenLoader_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <ScreenLoader_TT.h>
+#include <pgmspace_GFX.h>
+#include <new>
+
+/**************************************************************************/
+size_t ScreenLoader_TT::buttonSize(uint8_t type) {
+
+  size_t size;
+  switch (type) {
+  case BUTTON_DEF_TT_BUTTON:
+    size = sizeof(Button_TT);
+    break;
+  case BUTTON_DEF_TT_LABEL:
+    size = sizeof(Button_TT_label);
+    break;
+  case BUTTON_DEF_TT_ARROW:
+    size = sizeof(Button_TT_arrow);
+    break;
+  case BUTTON_DEF_TT_INT8:
+    size = sizeof(Button_TT_int8);
+    break;
+  case BUTTON_DEF_TT_UINT8:
+    size = sizeof(Button_TT_uint8);
+    break;
+  case BUTTON_DEF_TT_INT16:
+    size = sizeof(Button_TT_int16);
+    break;
+  case BUTTON_DEF_TT_UINT16:
+    size = sizeof(Button_TT_uint16);
+    break;
+  default:
+    return (0);
+  }
+  // Keep the next button aligned for a pointer.
+  return (BUTTON_TT_ROUND(size));
+}
+
+/**************************************************************************/
+size_t ScreenLoader_TT::storageSize(const ButtonDef_TT* defs, uint8_t n) {
+
+  size_t size = 0;
+  for (uint8_t i = 0; i < n; i++)
+    size += buttonSize(pgm_read_byte(&defs[i].type));
+  return (size);
+}
+
+/**************************************************************************/
+Button_TT* ScreenLoader_TT::create(const ButtonDef_TT* def, void* p) {
+
+  // Copy the fields of the definition from PROGMEM.
+  uint8_t type = pgm_read_byte(&def->type);
+  char align[3];
+  for (uint8_t i = 0; i < 3; i++)
+    align[i] = pgm_read_byte(&def->align[i]);
+  int16_t x = (int16_t)pgm_read_word(&def->x);
+  int16_t y = (int16_t)pgm_read_word(&def->y);
+  int16_t w = (int16_t)pgm_read_word(&def->w);
+  int16_t h = (int16_t)pgm_read_word(&def->h);
+  uint8_t flags = pgm_read_byte(&def->flags);
+  bool degreeSym = (flags & BUTTON_DEF_TT_DEGREE_SYMBOL) != 0;
+  bool showPlus = (flags & BUTTON_DEF_TT_SHOW_PLUS) != 0;
+  char orient = pgm_read_byte(&def->orient);
+  int16_t value = (int16_t)pgm_read_word(&def->value);
+  int16_t minValue = (int16_t)pgm_read_word(&def->minValue);
+  int16_t maxValue = (int16_t)pgm_read_word(&def->maxValue);
+
+  // Copy the label from PROGMEM.
+  char label[SCREEN_LOADER_TT_MAX_LABEL + 1];
+  const char* s = (const char*)pgm_read_pointer(&def->label);
+  uint8_t n = 0;
+  if (s != nullptr)
+    while (n < SCREEN_LOADER_TT_MAX_LABEL &&
+        (label[n] = pgm_read_byte(s + n)) != 0)
+      n++;
+  label[n] = 0;
+
+  // Take the colors, font, etc. from the button's style.
+  ButtonStyle_TT* style = _styles[pgm_read_byte(&def->style)];
+  uint16_t outline = style->getOutlineColor();
+  uint16_t fill = style->getFillColor();
+  uint16_t text = style->getTextColor();
+  const char* textAlign = style->getTextAlign();
+  Font_TT* f = style->getFont();
+  int16_t r = style->getCornerRadius();
+  uint8_t expU, expD, expL, expR;
+  style->getExpansion(expU, expD, expL, expR);
+
+  Button_TT* btn;
+  switch (type) {
+  case BUTTON_DEF_TT_BUTTON:
+    btn = new (p) Button_TT("", _gfx, align, x, y, w, h, outline, fill, expU,
+      expD, expL, expR);
+    break;
+  case BUTTON_DEF_TT_LABEL:
+    btn = new (p) Button_TT_label("", _gfx, align, x, y, w, h, outline, fill,
+      text, textAlign, label, degreeSym, f, r, expU, expD, expL, expR);
+    break;
+  case BUTTON_DEF_TT_ARROW:
+    btn = new (p) Button_TT_arrow("", _gfx, orient, align, x, y, w, h,
+      outline, fill, expU, expD, expL, expR);
+    break;
+  case BUTTON_DEF_TT_INT8:
+    btn = new (p) Button_TT_int8("", _gfx, align, x, y, w, h, outline, fill,
+      text, textAlign, f, r, value, minValue, maxValue, degreeSym, showPlus,
+      nullptr, expU, expD, expL, expR);
+    break;
+  case BUTTON_DEF_TT_UINT8:
+    btn = new (p) Button_TT_uint8("", _gfx, align, x, y, w, h, outline, fill,
+      text, textAlign, f, r, value, minValue, maxValue, degreeSym, nullptr,
+      nullptr, expU, expD, expL, expR);
+    break;
+  case BUTTON_DEF_TT_INT16:
+    btn = new (p) Button_TT_int16("", _gfx, align, x, y, w, h, outline, fill,
+      text, textAlign, f, r, value, minValue, maxValue, degreeSym, showPlus,
+      nullptr, expU, expD, expL, expR);
+    break;
+  case BUTTON_DEF_TT_UINT16:
+    btn = new (p) Button_TT_uint16("", _gfx, align, x, y, w, h, outline,
+      fill, text, textAlign, f, r, value, minValue, maxValue, degreeSym,
+      nullptr, nullptr, expU, expD, expL, expR);
+    break;
+  default:
+    return (nullptr);
+  }
+  return (btn);
+}
+
+/**************************************************************************/
+bool ScreenLoader_TT::load(const ButtonDef_TT* defs, uint8_t n) {
+
+  unload();
+  if (n > SCREEN_LOADER_TT_MAX_BUTTONS || storageSize(defs, n) > _size)
+    return (false);
+  for (uint8_t i = 0; i < n; i++)
+    if (buttonSize(pgm_read_byte(&defs[i].type)) == 0)
+      return (false);
+
+  _defs = defs;
+  uint8_t* p = _storage;
+  for (uint8_t i = 0; i < n; i++) {
+    _buttons[i] = create(&defs[i], p);
+    _numButtons++;
+    p += buttonSize(pgm_read_byte(&defs[i].type));
+    // The button follows later changes to its style.
+    if (!_styles[pgm_read_byte(&defs[i].style)]->addButton(*_buttons[i])) {
+      unload();
+      return (false);
+    }
+    uint8_t press = pgm_read_byte(&defs[i].press);
+    if (press != BUTTON_DEF_TT_NONE)
+      _collection->registerButton(*_buttons[i], _pressFuncs[press]);
+  }
+  return (true);
+}
+
+/**************************************************************************/
+void ScreenLoader_TT::unload(void) {
+
+  if (_numButtons == 0)
+    return;
+  // Clear the collection first, since clearing it may draw a pressed button.
+  _collection->clear();
+
+  // The button classes have no virtual destructor, so destroy each button
+  // through its own class, after removing it from its style.
+  for (uint8_t i = 0; i < _numButtons; i++) {
+    Button_TT* btn = _buttons[i];
+    _styles[pgm_read_byte(&_defs[i].style)]->removeButton(*btn);
+    switch (pgm_read_byte(&_defs[i].type)) {
+    case BUTTON_DEF_TT_BUTTON:
+      btn->~Button_TT();
+      break;
+    case BUTTON_DEF_TT_LABEL:
+      ((Button_TT_label*)btn)->~Button_TT_label();
+      break;
+    case BUTTON_DEF_TT_ARROW:
+      ((Button_TT_arrow*)btn)->~Button_TT_arrow();
+      break;
+    case BUTTON_DEF_TT_INT8:
+      ((Button_TT_int8*)btn)->~Button_TT_int8();
+      break;
+    case BUTTON_DEF_TT_UINT8:
+      ((Button_TT_uint8*)btn)->~Button_TT_uint8();
+      break;
+    case BUTTON_DEF_TT_INT16:
+      ((Button_TT_int16*)btn)->~Button_TT_int16();
+      break;
+    case BUTTON_DEF_TT_UINT16:
+      ((Button_TT_uint16*)btn)->~Button_TT_uint16();
+      break;
+    }
+    _buttons[i] = nullptr;
+  }
+  _numButtons = 0;
+  _defs = nullptr;
+}
+
+/**************************************************************************/
+uint8_t ScreenLoader_TT::drawIfChanged(bool forceDraw) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < _numButtons; i++)
+    if (_buttons[i]->drawIfChanged(forceDraw))
+      n++;
+  return (n);
+}
+
+// -------------------------------------------------------------------------
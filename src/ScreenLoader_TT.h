@@ -0,0 +1,285 @@
+/*
+  ScreenLoader_TT.h - Defines struct ButtonDef_TT, which describes a button of
+  a screen in a table kept in PROGMEM, and C++ class ScreenLoader_TT, which
+  creates the buttons of a screen from such a table when the screen is shown.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  A screen is usually built by defining a global variable for each of its
+  buttons, each initialized with a long list of arguments, and registering
+  the buttons in a Button_TT_collection. All the buttons of all the screens
+  then take RAM all the time, and they are all constructed before setup() is
+  called.
+
+  Instead, the buttons of a screen can be described by an array of
+  ButtonDef_TT structs in PROGMEM, one per button, giving its type, position
+  and size, the index of its style in a table of ButtonStyle_TT objects (see
+  ButtonStyle_TT.h), which supplies its colors, font, text alignment, corner
+  radius and touch margins, the index of its press processing function in a
+  table of functions, its label text (a PROGMEM string) and its value range.
+
+  A ScreenLoader_TT object is given a buffer of RAM for the buttons of one
+  screen, the display, the table of styles and the table of functions, and a
+  Button_TT_collection. Its load() function destroys the buttons of the
+  screen loaded before, if any, creates the buttons of a new screen in the
+  buffer from its definition, adds each to its style, and registers each that
+  has a press processing function in the collection (the others can't be
+  pressed). Its drawIfChanged() function draws them all. The RAM used for
+  buttons is then only that of the screen being shown, the size of the
+  buffer, which is set to the size needed by the largest screen (see
+  storageSize()), and nothing is constructed before setup() is called.
+
+  Integer-valued buttons are created with no value check function and no zero
+  string. A label is copied from PROGMEM into RAM, and is cut to at most
+  SCREEN_LOADER_TT_MAX_LABEL characters.
+
+  A loaded button can be found with getButton(), by its index in the screen
+  definition. The loader owns the buttons: a pointer to one must not be used
+  after another screen is loaded.
+
+  Example:
+
+    const char strTitle[] PROGMEM = "Settings";
+    const ButtonDef_TT settingsScreen[] PROGMEM = {
+      // type              align   x    y    w    h  style press flags  orient
+      //   label      value min max
+      { BUTTON_DEF_TT_LABEL, "TC", 160,   5,  -4,  -4,  0, BUTTON_DEF_TT_NONE,
+        0, 0, strTitle, 0,  0,  0 },
+      { BUTTON_DEF_TT_UINT8, "CC", 160, 120,  60,  30,  1,  0,
+        0, 0, nullptr,  20, 0, 99 },
+      { BUTTON_DEF_TT_ARROW, "CL", 200, 120,  30,  20,  1,  1,
+        0, 'R', nullptr, 0, 0, 0 },
+    };
+    ...
+    ButtonStyle_TT* styles[] = { &titleStyle, &valueStyle };
+    void (*pressFuncs[])(Button_TT& btn) = { onValue, onIncrement };
+    void* screenRAM[120];
+    ScreenLoader_TT loader(lcd, screenRAM, sizeof(screenRAM), screenButtons,
+      styles, pressFuncs);
+    ...
+    loader.load(settingsScreen, 3);
+    lcd->fillScreen(ILI9341_BLACK);
+    loader.drawIfChanged(true);
+*/
+#ifndef ScreenLoader_TT_h
+#define ScreenLoader_TT_h
+
+#include <Arduino.h>
+#include <Button_TT_collection.h>
+#include <Button_TT_label.h>
+#include <Button_TT_arrow.h>
+#include <Button_TT_int8.h>
+#include <Button_TT_uint8.h>
+#include <Button_TT_int16.h>
+#include <Button_TT_uint16.h>
+#include <ButtonStyle_TT.h>
+
+// Button types of ButtonDef_TT::type, the classes of the buttons created.
+#define BUTTON_DEF_TT_BUTTON  0     // Button_TT
+#define BUTTON_DEF_TT_LABEL   1     // Button_TT_label
+#define BUTTON_DEF_TT_ARROW   2     // Button_TT_arrow
+#define BUTTON_DEF_TT_INT8    3     // Button_TT_int8
+#define BUTTON_DEF_TT_UINT8   4     // Button_TT_uint8
+#define BUTTON_DEF_TT_INT16   5     // Button_TT_int16
+#define BUTTON_DEF_TT_UINT16  6     // Button_TT_uint16
+
+// Flags of ButtonDef_TT::flags.
+#define BUTTON_DEF_TT_DEGREE_SYMBOL 0x01  // Append a degree symbol.
+#define BUTTON_DEF_TT_SHOW_PLUS     0x02  // Show "+" (int8 and int16 buttons).
+
+// ButtonDef_TT::press value for a button with no press processing function.
+#define BUTTON_DEF_TT_NONE 0xFF
+
+// Maximum number of buttons in a screen.
+#define SCREEN_LOADER_TT_MAX_BUTTONS MAX_BUTTONS_IN_COLLECTION
+
+// Maximum length of a label in a screen definition.
+#define SCREEN_LOADER_TT_MAX_LABEL 40
+
+/**************************************************************************/
+/*!
+  @brief  Definition of one button of a screen, kept in PROGMEM.
+*/
+/**************************************************************************/
+struct ButtonDef_TT {
+  uint8_t type;       // Button type, BUTTON_DEF_TT_*.
+  char align[3];      // Alignment of (x,y), see Button_TT::initButton().
+  int16_t x, y;       // Position of the button.
+  int16_t w, h;       // Size of the button, or for an arrow button the lengths
+                      // of the base and lateral sides of its triangle.
+  uint8_t style;      // Index of the button's style in the style table.
+  uint8_t press;      // Index of the button's press processing function in
+                      // the function table, BUTTON_DEF_TT_NONE if none.
+  uint8_t flags;      // BUTTON_DEF_TT_DEGREE_SYMBOL, BUTTON_DEF_TT_SHOW_PLUS.
+  char orient;        // Orientation of an arrow button: U, D, L, or R.
+  const char* label;  // Label of a label button, in PROGMEM, nullptr if none.
+  int16_t value;      // Initial value of an integer-valued button.
+  int16_t minValue;   // Minimum and maximum value of an integer-valued button.
+  int16_t maxValue;
+};
+
+/**************************************************************************/
+/*!
+  @brief  A class that creates the buttons of a screen from a ButtonDef_TT
+          array in PROGMEM, in a RAM buffer that it reuses for each screen.
+*/
+/**************************************************************************/
+class ScreenLoader_TT {
+
+protected:
+
+  Adafruit_GFX* _gfx;                 // The display.
+  uint8_t* _storage;                  // RAM buffer for the buttons.
+  size_t _size;                       // Size of _storage in bytes.
+  Button_TT_collection* _collection;  // Collection of the loaded buttons.
+  ButtonStyle_TT** _styles;           // Table of styles.
+  void (**_pressFuncs)(Button_TT& btn); // Table of press functions.
+
+  // The loaded screen definition, its buttons, and the number of buttons.
+  const ButtonDef_TT* _defs;
+  Button_TT* _buttons[SCREEN_LOADER_TT_MAX_BUTTONS];
+  uint8_t _numButtons;
+
+  /**************************************************************************/
+  // Return the number of bytes of storage taken by a button of type 'type',
+  // 0 if the type is invalid.
+  /**************************************************************************/
+  static size_t buttonSize(uint8_t type);
+
+  /**************************************************************************/
+  // Create the button defined by 'def', in PROGMEM, at 'p'.
+  /**************************************************************************/
+  Button_TT* create(const ButtonDef_TT* def, void* p);
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    gfx         The display on which the buttons are drawn.
+    @param    storage     RAM buffer for the buttons of a screen, aligned for
+                          a pointer (e.g. an array of void*).
+    @param    size        Size of storage in bytes.
+    @param    collection  Collection in which the loaded buttons are
+                          registered.
+    @param    styles      Table of the styles given by ButtonDef_TT::style.
+    @param    pressFuncs  Table of the press processing functions given by
+                          ButtonDef_TT::press, nullptr if none is used.
+  */
+  /**************************************************************************/
+  ScreenLoader_TT(Adafruit_GFX* gfx, void* storage, size_t size,
+      Button_TT_collection* collection, ButtonStyle_TT** styles,
+      void (**pressFuncs)(Button_TT& btn) = nullptr) {
+    _gfx = gfx;
+    _collection = collection;
+    _storage = (uint8_t*)storage;
+    _size = size;
+    _styles = styles;
+    _pressFuncs = pressFuncs;
+    _defs = nullptr;
+    _numButtons = 0;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Destructor, unloads the screen.
+  */
+  /**************************************************************************/
+  ~ScreenLoader_TT() { unload(); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the storage size needed by a screen.
+    @param    defs    The screen definition, in PROGMEM.
+    @param    n       Number of buttons in defs.
+    @returns  Number of bytes of storage needed by the buttons of the screen.
+  */
+  /**************************************************************************/
+  static size_t storageSize(const ButtonDef_TT* defs, uint8_t n);
+
+  /**************************************************************************/
+  /*!
+    @brief    Unload the screen loaded before, if any, and load a screen:
+              create its buttons and register them in the collection. The
+              buttons are not drawn.
+    @param    defs    The screen definition, in PROGMEM.
+    @param    n       Number of buttons in defs.
+    @returns  true if successful, false if a button type is invalid, there
+              are too many buttons, the storage is too small, or a style has
+              too many buttons (see ButtonStyle_TT::addButton()), in which
+              case no screen is loaded.
+  */
+  /**************************************************************************/
+  bool load(const ButtonDef_TT* defs, uint8_t n);
+
+  /**************************************************************************/
+  /*!
+    @brief    Unload the loaded screen, if any: clear the collection, remove
+              the buttons from their styles and destroy them.
+  */
+  /**************************************************************************/
+  void unload(void);
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of buttons of the loaded screen.
+    @returns  The number of buttons, 0 if no screen is loaded.
+  */
+  /**************************************************************************/
+  uint8_t getNumButtons(void) { return (_numButtons); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get a button of the loaded screen.
+    @param    i       Index of the button in the screen definition.
+    @returns  Pointer to the button, of the class given by its type, nullptr
+              if i is out of range.
+  */
+  /**************************************************************************/
+  Button_TT* getButton(uint8_t i) {
+    return ((i < _numButtons) ? _buttons[i] : nullptr);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Redraw each button of the loaded screen that has changed since
+              it was last drawn (see Button_TT::drawIfChanged()), including
+              the buttons that aren't registered in the collection.
+    @param    forceDraw     If true, all buttons are drawn.
+    @returns  The number of buttons drawn.
+  */
+  /**************************************************************************/
+  uint8_t drawIfChanged(bool forceDraw = false);
+};
+
+#endif // ScreenLoader_TT_h
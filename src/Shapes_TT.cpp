@@ -0,0 +1,446 @@
+/*
+  Shapes_TT.cpp - Defines functions of class Shapes_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <Shapes_TT.h>
+#include <Clip_TT.h>
+
+/**************************************************************************/
+Shapes_TT::Corner_TT* Shapes_TT::_corners = nullptr;
+Shapes_TT::Arrow_TT* Shapes_TT::_arrows = nullptr;
+
+/**************************************************************************/
+// Get the pixels that Adafruit_GFX drawLine() draws in row 'y' for the line
+// from (x0,y0) to (x1,y1), as the span a..b. If there are none, a > b.
+/**************************************************************************/
+static void lineSpan(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t y, int16_t& a, int16_t& b) {
+
+  a = 1;
+  b = 0;
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    int16_t t = x0; x0 = y0; y0 = t;
+    t = x1; x1 = y1; y1 = t;
+  }
+  if (x0 > x1) {
+    int16_t t = x0; x0 = x1; x1 = t;
+    t = y0; y0 = y1; y1 = t;
+  }
+  int16_t dx = x1 - x0;
+  int16_t dy = abs(y1 - y0);
+  int16_t err = dx / 2;
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+  for (; x0 <= x1; x0++) {
+    int16_t px = steep ? y0 : x0;
+    int16_t py = steep ? x0 : y0;
+    if (py == y) {
+      if (a > b)
+        a = b = px;
+      else if (px < a)
+        a = px;
+      else if (px > b)
+        b = px;
+    }
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+/**************************************************************************/
+const uint8_t* Shapes_TT::cornerInsets(uint8_t r) {
+
+  Corner_TT* c;
+  for (c = _corners; c != nullptr; c = c->next)
+    if (c->r == r)
+      return ((const uint8_t*)(c + 1));
+
+  c = (Corner_TT*)malloc(sizeof(Corner_TT) + r);
+  if (c == nullptr)
+    return (nullptr);
+  c->r = r;
+  c->next = _corners;
+  _corners = c;
+  uint8_t* inset = (uint8_t*)(c + 1);
+  memset(inset, r, r);
+
+  // Run the midpoint circle algorithm of Adafruit_GFX fillCircleHelper(),
+  // which fills column dx of the corner (dx = 1..r to the left of its center
+  // column) up to dy rows above its center row. Row r-dy of the table then
+  // extends at least to column dx, and so does every row below it.
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  int16_t px = x;
+  int16_t py = y;
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (x < y + 1 && y > 0 && r - x < inset[r - y])
+      inset[r - y] = r - x;
+    if (y != py) {
+      if (px > 0 && r - py < inset[r - px])
+        inset[r - px] = r - py;
+      py = y;
+    }
+    px = x;
+  }
+  for (uint8_t i = 1; i < r; i++)
+    if (inset[i] > inset[i - 1])
+      inset[i] = inset[i - 1];
+  return (inset);
+}
+
+/**************************************************************************/
+void Shapes_TT::fillRoundRect(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    int16_t w, int16_t h, int16_t r, uint16_t color, bool cornersOnly) {
+
+  r = limitRadius(w, h, r);
+  if (r < 0)
+    r = 0;
+  const uint8_t* inset = nullptr;
+  if (r > 0) {
+    if (r <= 255)
+      inset = cornerInsets(r);
+    if (inset == nullptr) {
+      if (Clip_TT::isClipped()) {
+        ClipGFX_TT clipped(gfx);
+        clipped.fillRoundRect(x, y, w, h, r, color);
+      } else
+        gfx->fillRoundRect(x, y, w, h, r, color);
+      return;
+    }
+  }
+
+  gfx->startWrite();
+  for (int16_t i = 0; i < r; i++) {
+    int16_t n = w - 2 * inset[i];
+    if (n > 0) {
+      Clip_TT::writeFastHLine(gfx, x + inset[i], y + i, n, color);
+      Clip_TT::writeFastHLine(gfx, x + inset[i], y + h - 1 - i, n, color);
+    }
+  }
+  if (!cornersOnly && h > 2 * r)
+    Clip_TT::writeFillRect(gfx, x, y + r, w, h - 2 * r, color);
+  gfx->endWrite();
+}
+
+/**************************************************************************/
+void Shapes_TT::drawRoundRect(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    int16_t w, int16_t h, int16_t r, uint16_t color, bool cornersOnly) {
+
+  r = limitRadius(w, h, r);
+  if (r <= 0) {
+    if (!cornersOnly)
+      Clip_TT::drawRect(gfx, x, y, w, h, color);
+    return;
+  }
+  const uint8_t* inset = (r <= 255) ? cornerInsets(r) : nullptr;
+  if (inset == nullptr) {
+    if (Clip_TT::isClipped()) {
+      ClipGFX_TT clipped(gfx);
+      clipped.drawRoundRect(x, y, w, h, r, color);
+    } else
+      gfx->drawRoundRect(x, y, w, h, r, color);
+    return;
+  }
+
+  gfx->startWrite();
+  for (int16_t i = 0; i < r; i++) {
+    // The outline of a corner row runs from the row's inset to one pixel
+    // short of the inset of the row above it, or is a single pixel if that
+    // is no wider. The top row is outlined across its full width.
+    int16_t a = inset[i];
+    int16_t n = w - 2 * a;
+    int16_t m = (i == 0) ? n : inset[i - 1] - a;
+    if (m < 1)
+      m = 1;
+    if (n <= 0)
+      continue;
+    if (2 * m >= n) {
+      Clip_TT::writeFastHLine(gfx, x + a, y + i, n, color);
+      Clip_TT::writeFastHLine(gfx, x + a, y + h - 1 - i, n, color);
+    } else {
+      Clip_TT::writeFastHLine(gfx, x + a, y + i, m, color);
+      Clip_TT::writeFastHLine(gfx, x + w - a - m, y + i, m, color);
+      Clip_TT::writeFastHLine(gfx, x + a, y + h - 1 - i, m, color);
+      Clip_TT::writeFastHLine(gfx, x + w - a - m, y + h - 1 - i, m, color);
+    }
+  }
+  if (!cornersOnly && h > 2 * r) {
+    Clip_TT::writeFastVLine(gfx, x, y + r, h - 2 * r, color);
+    Clip_TT::writeFastVLine(gfx, x + w - 1, y + r, h - 2 * r, color);
+  }
+  gfx->endWrite();
+}
+
+/**************************************************************************/
+void Shapes_TT::fillRing(Adafruit_GFX* gfx, int16_t x0, int16_t y0,
+    int16_t rO, int16_t rI, uint16_t color) {
+
+  if (rO < 0 || rO > 255)
+    return;
+  if (rI > 255)
+    rI = 255;
+  const uint8_t* insetO = (rO > 0) ? cornerInsets(rO) : nullptr;
+  const uint8_t* insetI = (rI > 0) ? cornerInsets(rI) : nullptr;
+  if ((rO > 0 && insetO == nullptr) || (rI > 0 && insetI == nullptr)) {
+    if (Clip_TT::isClipped()) {
+      ClipGFX_TT clipped(gfx);
+      clipped.fillCircle(x0, y0, rO, color);
+    } else
+      gfx->fillCircle(x0, y0, rO, color);
+    return;
+  }
+
+  gfx->startWrite();
+  for (int16_t dy = -rO; dy <= rO; dy++) {
+    // Half widths of the two circles in this row, the inner one -1 if the
+    // row is outside it.
+    int16_t ady = (dy < 0) ? -dy : dy;
+    int16_t hwO = (ady == 0) ? rO : rO - insetO[rO - ady];
+    int16_t hwI = -1;
+    if (ady <= rI)
+      hwI = (ady == 0) ? rI : rI - insetI[rI - ady];
+    if (hwI < 0)
+      Clip_TT::writeFastHLine(gfx, x0 - hwO, y0 + dy, 2 * hwO + 1, color);
+    else if (hwI < hwO) {
+      Clip_TT::writeFastHLine(gfx, x0 - hwO, y0 + dy, hwO - hwI, color);
+      Clip_TT::writeFastHLine(gfx, x0 + hwI + 1, y0 + dy, hwO - hwI, color);
+    }
+  }
+  gfx->endWrite();
+}
+
+/**************************************************************************/
+void Shapes_TT::arrowVertices(uint16_t w, uint16_t h, char orient,
+    int16_t vx[3], int16_t vy[3]) {
+
+  // Vertex 0 is the tip, 1 and 2 follow it clockwise, in the order that
+  // Button_TT_arrow has always passed them to Adafruit_GFX.
+  vx[0] = vx[1] = vx[2] = 0;
+  vy[0] = vy[1] = vy[2] = 0;
+  if (orient == 'U') {
+    vx[0] = w / 2;
+    vx[1] = w;
+    vy[1] = vy[2] = h;
+  } else if (orient == 'D') {
+    vx[0] = w / 2;
+    vy[0] = h;
+    vx[2] = w;
+  } else if (orient == 'L') {
+    vy[0] = h / 2;
+    vx[1] = vx[2] = w;
+    vy[2] = h;
+  } else { // Assume 'R'
+    vx[0] = w;
+    vy[0] = h / 2;
+    vy[1] = h;
+  }
+}
+
+/**************************************************************************/
+const Shapes_TT::ArrowSpan_TT* Shapes_TT::arrowSpans(uint16_t w, uint16_t h,
+    char orient) {
+
+  Arrow_TT* t;
+  for (t = _arrows; t != nullptr; t = t->next)
+    if (t->w == w && t->h == h && t->orient == orient)
+      return ((const ArrowSpan_TT*)(t + 1));
+
+  if (w > 255 || h > 255)
+    return (nullptr);
+  t = (Arrow_TT*)malloc(sizeof(Arrow_TT) + (h + 1) * sizeof(ArrowSpan_TT));
+  if (t == nullptr)
+    return (nullptr);
+  ArrowSpan_TT* spans = (ArrowSpan_TT*)(t + 1);
+  memset(spans, 0, (h + 1) * sizeof(ArrowSpan_TT));
+
+  // The outline of each row is the union of the spans of the three lines,
+  // which must leave at most one gap, as it does for any triangle.
+  int16_t vx[4], vy[4];
+  arrowVertices(w, h, orient, vx, vy);
+  vx[3] = vx[0];
+  vy[3] = vy[0];
+  for (int16_t y = 0; y <= (int16_t)h; y++) {
+    int16_t a[3], b[3], n = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+      lineSpan(vx[i], vy[i], vx[i + 1], vy[i + 1], y, a[n], b[n]);
+      if (a[n] <= b[n]) {
+        // Insertion sort by start.
+        for (int16_t j = n; j > 0 && a[j] < a[j - 1]; j--) {
+          int16_t ta = a[j]; a[j] = a[j - 1]; a[j - 1] = ta;
+          int16_t tb = b[j]; b[j] = b[j - 1]; b[j - 1] = tb;
+        }
+        n++;
+      }
+    }
+    int16_t m = 0;
+    for (int16_t i = 1; i < n; i++) {
+      if (a[i] <= b[m] + 1) {
+        if (b[i] > b[m])
+          b[m] = b[i];
+      } else {
+        m++;
+        a[m] = a[i];
+        b[m] = b[i];
+      }
+    }
+    if (m > 1) {
+      free(t);
+      return (nullptr);
+    }
+    ArrowSpan_TT& s = spans[y];
+    s.holeA = 1;
+    s.holeB = 0;
+    if (n == 0) {
+      s.lineA = 1;
+      s.lineB = 0;
+    } else {
+      s.lineA = a[0];
+      s.lineB = b[m];
+      if (m == 1) {
+        s.holeA = b[0] + 1;
+        s.holeB = a[1] - 1;
+      }
+    }
+    s.fillA = 1;
+    s.fillB = 0;
+  }
+
+  // Run the algorithm of Adafruit_GFX fillTriangle(), which fills one span
+  // of each row between the vertices' rows.
+  int16_t x0 = vx[0], y0 = vy[0], x1 = vx[1], y1 = vy[1], x2 = vx[2],
+    y2 = vy[2];
+  int16_t a, b, y, last;
+  if (y0 > y1) {
+    a = y0; y0 = y1; y1 = a;
+    a = x0; x0 = x1; x1 = a;
+  }
+  if (y1 > y2) {
+    a = y2; y2 = y1; y1 = a;
+    a = x2; x2 = x1; x1 = a;
+  }
+  if (y0 > y1) {
+    a = y0; y0 = y1; y1 = a;
+    a = x0; x0 = x1; x1 = a;
+  }
+  if (y0 == y2) {
+    a = b = x0;
+    if (x1 < a)
+      a = x1;
+    else if (x1 > b)
+      b = x1;
+    if (x2 < a)
+      a = x2;
+    else if (x2 > b)
+      b = x2;
+    spans[y0].fillA = a;
+    spans[y0].fillB = b;
+  } else {
+    int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+            dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+    last = (y1 == y2) ? y1 : y1 - 1;
+    for (y = y0; y <= last; y++) {
+      a = x0 + sa / dy01;
+      b = x0 + sb / dy02;
+      sa += dx01;
+      sb += dx02;
+      spans[y].fillA = (a < b) ? a : b;
+      spans[y].fillB = (a < b) ? b : a;
+    }
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++) {
+      a = x1 + sa / dy12;
+      b = x0 + sb / dy02;
+      sa += dx12;
+      sb += dx02;
+      spans[y].fillA = (a < b) ? a : b;
+      spans[y].fillB = (a < b) ? b : a;
+    }
+  }
+
+  t->w = w;
+  t->h = h;
+  t->orient = orient;
+  t->next = _arrows;
+  _arrows = t;
+  return (spans);
+}
+
+/**************************************************************************/
+void Shapes_TT::fillArrow(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    uint16_t h, const ArrowSpan_TT* spans, uint16_t color) {
+
+  gfx->startWrite();
+  for (uint16_t i = 0; i <= h; i++, spans++)
+    if (spans->fillA <= spans->fillB)
+      Clip_TT::writeFastHLine(gfx, x + spans->fillA, y + i,
+        spans->fillB - spans->fillA + 1, color);
+  gfx->endWrite();
+}
+
+/**************************************************************************/
+void Shapes_TT::drawArrow(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    uint16_t h, const ArrowSpan_TT* spans, uint16_t color) {
+
+  gfx->startWrite();
+  for (uint16_t i = 0; i <= h; i++, spans++) {
+    if (spans->lineA > spans->lineB)
+      continue;
+    if (spans->holeA > spans->holeB)
+      Clip_TT::writeFastHLine(gfx, x + spans->lineA, y + i,
+        spans->lineB - spans->lineA + 1, color);
+    else {
+      Clip_TT::writeFastHLine(gfx, x + spans->lineA, y + i,
+        spans->holeA - spans->lineA, color);
+      Clip_TT::writeFastHLine(gfx, x + spans->holeB + 1, y + i,
+        spans->lineB - spans->holeB, color);
+    }
+  }
+  gfx->endWrite();
+}
+
+// -------------------------------------------------------------------------
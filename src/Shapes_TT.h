@@ -0,0 +1,262 @@
+/*
+  Shapes_TT.h - Defines C++ class Shapes_TT, with functions that draw the
+  shapes of buttons as horizontal spans using precomputed tables.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  Adafruit_GFX draws a rounded rectangle by computing the quarter circles of
+  its corners with the midpoint circle algorithm every time it is drawn,
+  filling them as many short vertical lines and outlining them pixel by
+  pixel. Shapes_TT instead computes the corners of each radius once, as a
+  table giving the inset from the left and right edges of each of the
+  corner's rows, and shares the table among all buttons using that radius.
+  A rounded rectangle is then filled with one horizontal line for each corner
+  row and one rectangle for the rows in between, and outlined with one or two
+  horizontal lines for each corner row. The pixels drawn are the same as
+  those drawn by Adafruit_GFX fillRoundRect() and drawRoundRect(), except
+  that the outline of a rectangle whose width or height is exactly twice the
+  radius follows the edge of its fill, where Adafruit_GFX draws the centers
+  of the facing corners one pixel apart.
+
+  The corner rows (the 'r' rows at the top and bottom) can also be drawn
+  alone, so that a button whose corners are unchanged can redraw just the
+  rows between them.
+
+  The same tables describe filled circles, a circle of radius r being a
+  rounded rectangle 2r+1 pixels square with corner radius r. fillRing() uses
+  them to draw a ring, such as the degree symbol of Button_TT_label, as one
+  or two horizontal lines per row, in the ring color only, leaving the hole
+  untouched. The ring has the same pixels as a circle drawn by Adafruit_GFX
+  fillCircle() with a smaller one drawn over it.
+
+  Arrow buttons (Button_TT_arrow) are triangles, which Adafruit_GFX fills by
+  sorting the vertices and interpolating two edges for each row, and outlines
+  with three Bresenham lines drawn pixel by pixel, every time they are drawn.
+  arrowSpans() runs those same algorithms once for each size and orientation
+  of arrow, recording for each row the span that is filled and the span that
+  is outlined, less any gap between the outline's two sides. fillArrow() and
+  drawArrow() then draw the triangle as one horizontal line per row for the
+  fill and one or two for the outline, with the same pixels as Adafruit_GFX.
+
+  Corner tables take r bytes and arrow tables 6 bytes per row (each plus a
+  small header), and are allocated from the heap on first use and never
+  freed. If allocation fails, the Adafruit_GFX functions are used instead.
+
+  The spans are limited to the clip rectangle of Clip_TT, if any.
+
+  All functions are static, there is no need to create an instance of the
+  class.
+*/
+#ifndef Shapes_TT_h
+#define Shapes_TT_h
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+/**************************************************************************/
+/*!
+  @brief  A class with functions for drawing button shapes as spans.
+*/
+/**************************************************************************/
+class Shapes_TT {
+
+protected:
+
+  // A corner table. The r row insets follow it in memory.
+  typedef struct Corner_TT {
+    struct Corner_TT* next;   // Next table, nullptr if none.
+    uint8_t r;                // Corner radius.
+  } Corner_TT;
+
+  // Corner tables computed so far.
+  static Corner_TT* _corners;
+
+  // An arrow table. The h+1 row spans follow it in memory.
+  typedef struct Arrow_TT {
+    struct Arrow_TT* next;    // Next table, nullptr if none.
+    uint16_t w, h;            // Width and height of the arrow.
+    char orient;              // Orientation, U, D, L, or R.
+  } Arrow_TT;
+
+  // Arrow tables computed so far.
+  static Arrow_TT* _arrows;
+
+  /**************************************************************************/
+  // Limit a corner radius 'r' to half of the smaller of 'w' and 'h', as
+  // Adafruit_GFX does.
+  /**************************************************************************/
+  static int16_t limitRadius(int16_t w, int16_t h, int16_t r) {
+    int16_t maxR = ((w < h) ? w : h) / 2;
+    return ((r > maxR) ? maxR : r);
+  }
+
+public:
+
+  // The spans of one row of an arrow, as offsets from its left edge. The
+  // outline is lineA..lineB less holeA..holeB, which is empty if holeA >
+  // holeB.
+  typedef struct ArrowSpan_TT {
+    uint8_t fillA, fillB;     // First and last pixel filled.
+    uint8_t lineA, lineB;     // First and last pixel outlined.
+    uint8_t holeA, holeB;     // First and last pixel not outlined in between.
+  } ArrowSpan_TT;
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the corner table for a radius, computing it if this is the
+              first use of the radius.
+    @param    r       The corner radius, 1..255.
+    @returns  Pointer to r insets, one for each row of a top corner from the
+              top row down, giving the number of pixels of the row, counted
+              from the left or right edge of the rectangle, outside the
+              rounded corner. nullptr if memory could not be allocated.
+  */
+  /**************************************************************************/
+  static const uint8_t* cornerInsets(uint8_t r);
+
+  /**************************************************************************/
+  /*!
+    @brief    Fill a rounded rectangle, like Adafruit_GFX::fillRoundRect().
+    @param    gfx         The display to draw on.
+    @param    x           Left edge of the rectangle.
+    @param    y           Top edge of the rectangle.
+    @param    w           Width of the rectangle.
+    @param    h           Height of the rectangle.
+    @param    r           Corner radius.
+    @param    color       Fill color.
+    @param    cornersOnly If true, fill only the r rows at the top and at
+                          the bottom of the rectangle.
+  */
+  /**************************************************************************/
+  static void fillRoundRect(Adafruit_GFX* gfx, int16_t x, int16_t y,
+      int16_t w, int16_t h, int16_t r, uint16_t color,
+      bool cornersOnly = false);
+
+  /**************************************************************************/
+  /*!
+    @brief    Outline a rounded rectangle, like Adafruit_GFX::drawRoundRect().
+    @param    gfx         The display to draw on.
+    @param    x           Left edge of the rectangle.
+    @param    y           Top edge of the rectangle.
+    @param    w           Width of the rectangle.
+    @param    h           Height of the rectangle.
+    @param    r           Corner radius.
+    @param    color       Outline color.
+    @param    cornersOnly If true, draw only the outline of the r rows at the
+                          top and at the bottom of the rectangle.
+  */
+  /**************************************************************************/
+  static void drawRoundRect(Adafruit_GFX* gfx, int16_t x, int16_t y,
+      int16_t w, int16_t h, int16_t r, uint16_t color,
+      bool cornersOnly = false);
+
+  /**************************************************************************/
+  /*!
+    @brief    Fill a ring, the pixels of a filled circle that are not in a
+              smaller concentric filled circle (see Adafruit_GFX
+              fillCircle()), leaving the inner circle untouched. If memory
+              for the corner tables can't be allocated, the outer circle is
+              filled, hole and all.
+    @param    gfx         The display to draw on.
+    @param    x0          Center x-coordinate.
+    @param    y0          Center y-coordinate.
+    @param    rO          Outer radius, 0..255.
+    @param    rI          Inner radius, 0..255, the hole is empty if < 0.
+    @param    color       Ring color.
+  */
+  /**************************************************************************/
+  static void fillRing(Adafruit_GFX* gfx, int16_t x0, int16_t y0, int16_t rO,
+      int16_t rI, uint16_t color);
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the arrow table for a size and orientation of arrow,
+              computing it if this is the first use of them.
+    @param    w       Arrow width, 1..255. The arrow's pixels extend from its
+                      left edge x to x+w and from its top edge y to y+h.
+    @param    h       Arrow height.
+    @param    orient  Direction the arrow points: U=UP, D=DOWN, L=LEFT,
+                      R=RIGHT. The tip is at the center of that side of the
+                      w x h box and the other two vertices are the corners of
+                      the opposite side.
+    @returns  Pointer to h+1 row spans, from the top row down. nullptr if w
+              is out of range or memory could not be allocated.
+  */
+  /**************************************************************************/
+  static const ArrowSpan_TT* arrowSpans(uint16_t w, uint16_t h, char orient);
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the vertices of an arrow, for drawing it with Adafruit_GFX
+              triangle functions when it has no table (see arrowSpans()).
+    @param    w       Arrow width.
+    @param    h       Arrow height.
+    @param    orient  Direction the arrow points, see arrowSpans().
+    @param    vx      Returns the X offsets of the vertices from the arrow's
+                      left edge: the tip, then the other two clockwise.
+    @param    vy      Returns the Y offsets of the vertices from its top edge.
+  */
+  /**************************************************************************/
+  static void arrowVertices(uint16_t w, uint16_t h, char orient, int16_t vx[3],
+    int16_t vy[3]);
+
+  /**************************************************************************/
+  /*!
+    @brief    Fill an arrow, like Adafruit_GFX::fillTriangle().
+    @param    gfx         The display to draw on.
+    @param    x           Left edge of the arrow.
+    @param    y           Top edge of the arrow.
+    @param    h           Arrow height.
+    @param    spans       The arrow's table, from arrowSpans().
+    @param    color       Fill color.
+  */
+  /**************************************************************************/
+  static void fillArrow(Adafruit_GFX* gfx, int16_t x, int16_t y, uint16_t h,
+      const ArrowSpan_TT* spans, uint16_t color);
+
+  /**************************************************************************/
+  /*!
+    @brief    Outline an arrow, like Adafruit_GFX::drawTriangle().
+    @param    gfx         The display to draw on.
+    @param    x           Left edge of the arrow.
+    @param    y           Top edge of the arrow.
+    @param    h           Arrow height.
+    @param    spans       The arrow's table, from arrowSpans().
+    @param    color       Outline color.
+  */
+  /**************************************************************************/
+  static void drawArrow(Adafruit_GFX* gfx, int16_t x, int16_t y, uint16_t h,
+      const ArrowSpan_TT* spans, uint16_t color);
+};
+
+#endif // Shapes_TT_h
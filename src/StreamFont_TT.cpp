@@ -0,0 +1,212 @@
+/*
+  StreamFont_TT.cpp - Defines functions of class StreamFont_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <StreamFont_TT.h>
+#include <Font_TT.h>
+
+// Get little-endian values from a buffer.
+static uint16_t get16(const uint8_t* p) { return (p[0] | (p[1] << 8)); }
+static uint32_t get32(const uint8_t* p) {
+  return (get16(p) | ((uint32_t)get16(p + 2) << 16));
+}
+
+/**************************************************************************/
+StreamFont_TT::StreamFont_TT(FontReader_TT* reader, size_t budget) {
+  _reader = reader;
+  _ranges = nullptr;
+  _numRanges = 0;
+  _numGlyphs = 0;
+  _glyphsOffset = 0;
+  _bitmapsOffset = 0;
+  _extTop = 0;
+  _extBottom = 0;
+  _bitmapFormat = GFX_TT_BITMAP_RAW;
+  _yAdvance = 0;
+  _head = nullptr;
+  _budget = budget;
+  _used = 0;
+  _hits = 0;
+  _misses = 0;
+}
+
+/**************************************************************************/
+StreamFont_TT::~StreamFont_TT() {
+  clear();
+  free(_ranges);
+}
+
+/**************************************************************************/
+bool StreamFont_TT::begin(void) {
+
+  uint8_t H[STREAM_FONT_TT_HEADER_SIZE];
+  if (!_reader->read(0, H, sizeof(H)) || memcmp(H, "GFTT", 4) != 0 ||
+      H[4] != 1)
+    return (false);
+  // Until the whole range table has been read, the font has no ranges, so
+  // a failure leaves it with no glyphs rather than a partial table.
+  clear();
+  free(_ranges);
+  _ranges = nullptr;
+  _numRanges = 0;
+  _bitmapFormat = H[5];
+  _yAdvance = H[6];
+  uint16_t numRanges = get16(H + 8);
+  _numGlyphs = get16(H + 10);
+  _extTop = (int16_t)get16(H + 12);
+  _extBottom = (int16_t)get16(H + 14);
+  uint32_t rangesOffset = get32(H + 16);
+  _glyphsOffset = get32(H + 20);
+  _bitmapsOffset = get32(H + 24);
+
+  // Read the range table into RAM, one entry at a time to avoid a second
+  // buffer.
+  GFXrange_TT* ranges = nullptr;
+  if (numRanges > 0) {
+    ranges = (GFXrange_TT*)malloc(numRanges * sizeof(GFXrange_TT));
+    if (ranges == nullptr)
+      return (false);
+  }
+  for (uint16_t i = 0; i < numRanges; i++) {
+    uint8_t R[STREAM_FONT_TT_RANGE_SIZE];
+    if (!_reader->read(rangesOffset + i * STREAM_FONT_TT_RANGE_SIZE, R,
+        sizeof(R))) {
+      free(ranges);
+      return (false);
+    }
+    ranges[i].first = get16(R);
+    ranges[i].last = get16(R + 2);
+    ranges[i].glyphIndex = get16(R + 4);
+  }
+  _ranges = ranges;
+  _numRanges = numRanges;
+  return (true);
+}
+
+/**************************************************************************/
+void StreamFont_TT::evict(size_t bytes) {
+  while (_head != nullptr && _used + bytes > _budget) {
+    // Remove the last entry in the list, the least recently used one.
+    Entry_TT** pp = &_head;
+    while ((*pp)->next != nullptr)
+      pp = &(*pp)->next;
+    _used -= entrySize((*pp)->size);
+    free(*pp);
+    *pp = nullptr;
+  }
+}
+
+/**************************************************************************/
+void StreamFont_TT::clear(void) {
+  while (_head != nullptr) {
+    Entry_TT* e = _head;
+    _head = e->next;
+    free(e);
+  }
+  _used = 0;
+}
+
+/**************************************************************************/
+StreamFont_TT::Entry_TT* StreamFont_TT::loadGlyph(uint16_t index) {
+
+  // Look for the glyph in the cache, moving it to the front of the list.
+  Entry_TT** pp = &_head;
+  for (Entry_TT* e = _head; e != nullptr; pp = &e->next, e = e->next) {
+    if (e->index == index) {
+      *pp = e->next;
+      e->next = _head;
+      _head = e;
+      _hits++;
+      return (e);
+    }
+  }
+  _misses++;
+
+  // Read the glyph table entry, then make room for the glyph and read its
+  // bitmap. A glyph larger than the budget is still read, into a cache that
+  // holds only it.
+  uint8_t G[STREAM_FONT_TT_GLYPH_SIZE];
+  if (index >= _numGlyphs || !_reader->read(_glyphsOffset +
+      (uint32_t)index * STREAM_FONT_TT_GLYPH_SIZE, G, sizeof(G)))
+    return (nullptr);
+  uint16_t size = get16(G + 4);
+  evict(entrySize(size));
+  Entry_TT* e = (Entry_TT*)malloc(entrySize(size));
+  if (e == nullptr)
+    return (nullptr);
+  if (size > 0 && !_reader->read(_bitmapsOffset + get32(G),
+      (uint8_t*)(&e->glyph + 1), size)) {
+    free(e);
+    return (nullptr);
+  }
+  e->index = index;
+  e->size = size;
+  e->glyph.bitmapOffset = 0;
+  e->glyph.width = G[6];
+  e->glyph.height = G[7];
+  e->glyph.xAdvance = G[8];
+  e->glyph.xOffset = (int8_t)G[9];
+  e->glyph.yOffset = (int8_t)G[10];
+  e->next = _head;
+  _head = e;
+  _used += entrySize(size);
+  return (e);
+}
+
+/**************************************************************************/
+const GFXglyph* StreamFont_TT::findGlyph(uint16_t c) {
+
+  // Binary search for the range containing c.
+  uint16_t lo = 0, hi = _numRanges;
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2;
+    const GFXrange_TT* r = _ranges + mid;
+    if (c < r->first)
+      hi = mid;
+    else if (c > r->last)
+      lo = mid + 1;
+    else {
+      Entry_TT* e = loadGlyph(r->glyphIndex + (c - r->first));
+      return (e ? &e->glyph : nullptr);
+    }
+  }
+  return (nullptr);
+}
+
+/**************************************************************************/
+void StreamFont_TT::prefetch(const char* str, bool inFlash) {
+  uint16_t c;
+  while ((c = Font_TT::nextChar(str, inFlash, true)))
+    findGlyph(c);
+}
+
+// -------------------------------------------------------------------------
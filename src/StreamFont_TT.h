@@ -0,0 +1,399 @@
+/*
+  StreamFont_TT.h - Defines C++ class StreamFont_TT, a font whose glyphs are
+  read as needed from external storage (such as SPI flash or an SD card) and
+  kept in a RAM cache, and class FontReader_TT, the interface it uses to read
+  the storage.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  Fonts linked into a program take up on-chip flash, which limits how many
+  fonts (and how many languages) a program can carry. A StreamFont_TT font
+  instead lives in a font file on external storage, and only the glyphs being
+  drawn are held in RAM. A Font_TT object constructed from a StreamFont_TT
+  measures and draws text exactly as it would the same font linked into the
+  program as a GFXfont_TT font, decoding strings as UTF-8.
+
+  The storage is read through a FontReader_TT object, whose single function
+  read() reads a block of bytes at a given offset in the font file. Derive a
+  class from it to read SPI flash, an SD card file, etc. Class
+  StreamFileReader_TT reads a font file using the C standard library, and is
+  available on Linux, for testing.
+
+  The glyphs that have been read (metrics and bitmap) are kept in a cache with
+  a fixed RAM budget, least recently used glyphs being discarded to make room
+  for new ones. TextRender_TT reads all the glyphs of a string into the cache
+  (see prefetch()) before starting to draw it, so that the storage is not
+  read while a display transaction is in progress (the storage and display
+  are often on the same SPI bus). Choose a budget that holds the glyphs of the
+  longest string drawn with the font, else glyphs are read again while
+  drawing.
+
+  A glyph pointer returned by a StreamFont_TT font (including by
+  Font_TT::getGlyph()) points into the cache and is valid only until the next
+  glyph of the font is looked up.
+
+  Font_TT and TextRender_TT read glyphs and bitmaps with pgm_read_byte() etc.,
+  so streaming fonts require a processor on which those read ordinary RAM as
+  well as flash (ARM, ESP32, etc.), not an AVR.
+
+  Use tools/gfxfont_stream.py to convert a GFXfont or GFXfont_TT header file to
+  a font file. The font file format is (all values little-endian):
+
+    Header, 28 bytes:
+      0   "GFTT"            Identifies the file.
+      4   uint8_t           Format version, 1.
+      5   uint8_t           bitmapFormat, a GFX_TT_BITMAP_* value.
+      6   uint8_t           yAdvance.
+      7   uint8_t           Reserved, 0.
+      8   uint16_t          numRanges.
+      10  uint16_t          numGlyphs.
+      12  int16_t           Smallest glyph yOffset (top of font extent).
+      14  int16_t           Largest glyph yOffset+height (bottom of extent).
+      16  uint32_t          File offset of range table.
+      20  uint32_t          File offset of glyph table.
+      24  uint32_t          File offset of bitmaps.
+    Range table, numRanges entries of 6 bytes, sorted by code point, see
+    GFXrange_TT in GFXfont_TT.h:
+      0   uint16_t          first
+      2   uint16_t          last
+      4   uint16_t          glyphIndex
+    Glyph table, numGlyphs entries of 12 bytes:
+      0   uint32_t          Offset of glyph bitmap from start of bitmaps.
+      4   uint16_t          Size of glyph bitmap in bytes.
+      6   uint8_t           width
+      7   uint8_t           height
+      8   uint8_t           xAdvance
+      9   int8_t            xOffset
+      10  int8_t            yOffset
+      11  uint8_t           Reserved, 0.
+    Bitmaps, in the format given by bitmapFormat.
+
+  The range table is read into RAM by begin(), 6 bytes per range.
+
+  Example:
+
+    StreamFileReader_TT reader("Sans12.gft");
+    StreamFont_TT sans12(&reader, 4096);
+    ...
+    if (!sans12.begin())
+      monitor.printf("Can't read font file\n");
+    Font_TT font(sans12);
+    TextRender_TT::drawText(gfx, &font, x, y, "Grüße", ILI9341_WHITE);
+*/
+#ifndef StreamFont_TT_h
+#define StreamFont_TT_h
+
+#include <Arduino.h>
+#include <gfxfont.h>
+#include <GFXfont_TT.h>
+
+// Set to 1 to include class StreamFileReader_TT, which reads font files using
+// the C standard library.
+#if defined(__linux__)
+#define STREAM_FONT_TT_FILE 1
+#else
+#define STREAM_FONT_TT_FILE 0
+#endif
+
+#if STREAM_FONT_TT_FILE
+#include <stdio.h>
+#endif
+
+// Size of the font file header and of each range and glyph table entry.
+#define STREAM_FONT_TT_HEADER_SIZE 28
+#define STREAM_FONT_TT_RANGE_SIZE 6
+#define STREAM_FONT_TT_GLYPH_SIZE 12
+
+/**************************************************************************/
+/*!
+  @brief  Interface for reading a font file from storage.
+*/
+/**************************************************************************/
+class FontReader_TT {
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Destructor.
+  */
+  /**************************************************************************/
+  virtual ~FontReader_TT() {}
+
+  /**************************************************************************/
+  /*!
+    @brief    Read bytes from the font file.
+    @param    offset  Offset in the file of the first byte to read.
+    @param    buf     Buffer to receive the bytes.
+    @param    n       Number of bytes to read.
+    @returns  true if all n bytes were read.
+  */
+  /**************************************************************************/
+  virtual bool read(uint32_t offset, uint8_t* buf, uint16_t n) = 0;
+};
+
+#if STREAM_FONT_TT_FILE
+/**************************************************************************/
+/*!
+  @brief  A FontReader_TT that reads a font file using the C standard library.
+*/
+/**************************************************************************/
+class StreamFileReader_TT : public FontReader_TT {
+
+protected:
+
+  FILE* _file;                // The open font file, nullptr if not open.
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor. Open a font file.
+    @param    path    Path name of the font file.
+  */
+  /**************************************************************************/
+  StreamFileReader_TT(const char* path) { _file = fopen(path, "rb"); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Destructor. Close the font file.
+  */
+  /**************************************************************************/
+  ~StreamFileReader_TT() {
+    if (_file != nullptr)
+      fclose(_file);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Read bytes from the font file, see FontReader_TT::read().
+  */
+  /**************************************************************************/
+  bool read(uint32_t offset, uint8_t* buf, uint16_t n) {
+    return (_file != nullptr && fseek(_file, offset, SEEK_SET) == 0 &&
+      fread(buf, 1, n, _file) == n);
+  }
+};
+#endif
+
+/**************************************************************************/
+/*!
+  @brief  A font read as needed from a font file through a FontReader_TT,
+          with a RAM cache of recently used glyphs.
+*/
+/**************************************************************************/
+class StreamFont_TT {
+
+protected:
+
+  // A cache entry. The glyph's bitmap follows it in memory, and the glyph's
+  // bitmapOffset is 0.
+  typedef struct Entry_TT {
+    struct Entry_TT* next;    // Next entry, in order of most recent use.
+    uint16_t index;           // Index of the glyph in the glyph table.
+    uint16_t size;            // Size of the glyph bitmap in bytes.
+    GFXglyph glyph;           // The glyph.
+  } Entry_TT;
+
+  FontReader_TT* _reader;     // Reader of the font file.
+  GFXrange_TT* _ranges;       // Range table, nullptr until begin() succeeds.
+  uint16_t _numRanges;        // Number of entries in _ranges[].
+  uint16_t _numGlyphs;        // Number of glyphs in the glyph table.
+  uint32_t _glyphsOffset;     // File offset of the glyph table.
+  uint32_t _bitmapsOffset;    // File offset of the bitmaps.
+  int16_t _extTop;            // Smallest glyph yOffset.
+  int16_t _extBottom;         // Largest glyph yOffset+height.
+  uint8_t _bitmapFormat;      // GFX_TT_BITMAP_* format of the bitmaps.
+  uint8_t _yAdvance;          // Newline distance in y-direction.
+
+  Entry_TT* _head;            // Most recently used entry, nullptr if empty.
+  size_t _budget;             // Maximum bytes used by entries.
+  size_t _used;               // Bytes currently used by entries.
+  uint32_t _hits;             // Number of glyph lookups found in the cache.
+  uint32_t _misses;           // Number of glyph lookups read from the file.
+
+  /**************************************************************************/
+  // Return the number of bytes used by an entry with an n byte bitmap.
+  /**************************************************************************/
+  static size_t entrySize(uint16_t n) { return (sizeof(Entry_TT) + n); }
+
+  /**************************************************************************/
+  // Discard least recently used entries until 'bytes' more bytes fit in the
+  // budget.
+  /**************************************************************************/
+  void evict(size_t bytes);
+
+  /**************************************************************************/
+  // Return the cache entry of glyph table entry 'index', reading it from the
+  // font file if it is not in the cache, and mark it as most recently used.
+  // Returns nullptr if the glyph could not be read.
+  /**************************************************************************/
+  Entry_TT* loadGlyph(uint16_t index);
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    reader  The reader of the font file.
+    @param    budget  Maximum number of bytes of RAM to use for cached glyphs.
+  */
+  /**************************************************************************/
+  StreamFont_TT(FontReader_TT* reader, size_t budget);
+
+  /**************************************************************************/
+  /*!
+    @brief    Destructor. Release memory used by the range table and cache.
+  */
+  /**************************************************************************/
+  ~StreamFont_TT();
+
+  /**************************************************************************/
+  /*!
+    @brief    Read the font file header and range table. This must be called
+              before the font is used.
+    @returns  true if successful, false if the file could not be read, is not
+              a font file, or memory could not be allocated.
+  */
+  /**************************************************************************/
+  bool begin(void);
+
+  /**************************************************************************/
+  /*!
+    @brief    Discard all cached glyphs.
+  */
+  /**************************************************************************/
+  void clear(void);
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the glyph for a code point, reading it from the font file
+              if it is not in the cache.
+    @param    c       The Unicode code point.
+    @returns  Pointer to the glyph in RAM, followed by its bitmap, or nullptr
+              if the font has no glyph for c or it could not be read. The
+              pointer is valid until the next call.
+  */
+  /**************************************************************************/
+  const GFXglyph* findGlyph(uint16_t c);
+
+  /**************************************************************************/
+  /*!
+    @brief    Read the glyphs of all characters of a string into the cache,
+              so that drawing the string doesn't need to read the font file.
+    @param    str     The string, UTF-8.
+    @param    inFlash true if the string is in PROGMEM.
+  */
+  /**************************************************************************/
+  void prefetch(const char* str, bool inFlash = false);
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the index in the font's glyph table of a glyph returned by
+              findGlyph(), which identifies the glyph after it has been
+              discarded from the cache.
+    @param    glyph   The glyph.
+    @returns  The glyph's index.
+  */
+  /**************************************************************************/
+  static uint16_t glyphIndex(const GFXglyph* glyph) {
+    return (((const Entry_TT*)((const uint8_t*)glyph -
+      offsetof(Entry_TT, glyph)))->index);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the format of the font's glyph bitmaps.
+    @returns  A GFX_TT_BITMAP_* value.
+  */
+  /**************************************************************************/
+  uint8_t getBitmapFormat(void) { return (_bitmapFormat); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the font's newline distance.
+    @returns  The yAdvance of the font.
+  */
+  /**************************************************************************/
+  uint8_t getYAdvance(void) { return (_yAdvance); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the vertical extent of the font's glyphs, unmagnified.
+    @param    top     Reference to variable to receive the smallest glyph
+                      yOffset.
+    @param    bottom  Reference to variable to receive the largest glyph
+                      yOffset+height.
+  */
+  /**************************************************************************/
+  void getExtent(int16_t &top, int16_t &bottom) {
+    top = _extTop;
+    bottom = _extBottom;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the cache budget.
+    @returns  The maximum number of bytes of RAM used for cached glyphs.
+  */
+  /**************************************************************************/
+  size_t getBudget(void) { return (_budget); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of bytes of RAM currently used by cached glyphs.
+    @returns  The number of bytes used.
+  */
+  /**************************************************************************/
+  size_t getUsed(void) { return (_used); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of glyph lookups that found the glyph in the
+              cache.
+    @returns  The number of cache hits.
+  */
+  /**************************************************************************/
+  uint32_t getHits(void) { return (_hits); }
+
+  /**************************************************************************/
+  /*!
+    @brief    Get the number of glyph lookups that read the glyph from the
+              font file.
+    @returns  The number of cache misses.
+  */
+  /**************************************************************************/
+  uint32_t getMisses(void) { return (_misses); }
+};
+
+#endif // StreamFont_TT_h
@@ -0,0 +1,288 @@
+/*
+  StripRender_TT.cpp - Defines functions of class StripRender_TT.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <StripRender_TT.h>
+#include <TextRender_TT.h>
+#include <Clip_TT.h>
+
+/**************************************************************************/
+bool StripRender_TT::registerButton(Button_TT& button) {
+
+  for (uint8_t i = 0; i < _numButtons; i++)
+    if (_buttons[i] == &button)
+      return (true);
+  if (_numButtons == STRIP_RENDER_TT_MAX_BUTTONS)
+    return (false);
+  _buttons[_numButtons++] = &button;
+  return (true);
+}
+
+/**************************************************************************/
+bool StripRender_TT::unregisterButton(Button_TT& button) {
+
+  for (uint8_t i = 0; i < _numButtons; i++) {
+    if (_buttons[i] == &button) {
+      _numButtons--;
+      for (; i < _numButtons; i++)
+        _buttons[i] = _buttons[i + 1];
+      return (true);
+    }
+  }
+  return (false);
+}
+
+/**************************************************************************/
+void StripRender_TT::fill(int16_t x, int16_t y, int16_t w, int16_t h,
+    uint16_t color) {
+
+  int32_t xR = (int32_t)x + w, yB = (int32_t)y + h;
+  if (x < 0)
+    x = 0;
+  if (y < _yS)
+    y = _yS;
+  if (xR > _width)
+    xR = _width;
+  if (yB > _yS + (int32_t)_hS)
+    yB = _yS + (int32_t)_hS;
+  if (x >= xR || y >= yB)
+    return;
+  #if STRIP_RENDER_TT_BITS == 16
+  uint16_t* row = _buffer + (int32_t)(y - _yS) * _width + x;
+  for (; y < yB; y++, row += _width)
+    for (int16_t i = 0; i < xR - x; i++)
+      row[i] = color;
+  #elif STRIP_RENDER_TT_BITS == 8
+  uint8_t index = Palette_TT::index(color);
+  uint8_t* row = _buffer + (int32_t)(y - _yS) * _stride + x;
+  for (; y < yB; y++, row += _stride)
+    memset(row, index, xR - x);
+  #else
+  // Two pixels per byte, the left one in the high 4 bits. Set a left pixel
+  // in the low 4 bits and a right pixel in the high 4 bits alone, and the
+  // bytes between them whole.
+  uint8_t index = Palette_TT::index(color, 16);
+  uint8_t* row = _buffer + (int32_t)(y - _yS) * _stride + x / 2;
+  for (; y < yB; y++, row += _stride) {
+    uint8_t* p = row;
+    int16_t i = x;
+    if (i & 1) {
+      *p = (*p & 0xF0) | index;
+      p++;
+      i++;
+    }
+    int16_t n = (xR - i) / 2;
+    memset(p, index * 0x11, n);
+    if ((xR - i) & 1)
+      p[n] = (p[n] & 0x0F) | (index << 4);
+  }
+  #endif
+}
+
+/**************************************************************************/
+void StripRender_TT::drawRGBBitmap(int16_t x, int16_t y,
+    const uint16_t* bitmap, int16_t w, int16_t h) {
+
+  // Limit the rectangle to the clip rectangle and the strip.
+  int16_t xC = x, yC = y, wC = w, hC = h;
+  if (!Clip_TT::clip(xC, yC, wC, hC))
+    return;
+  int32_t xR = (int32_t)xC + wC, yB = (int32_t)yC + hC;
+  if (xC < 0)
+    xC = 0;
+  if (yC < _yS)
+    yC = _yS;
+  if (xR > _width)
+    xR = _width;
+  if (yB > _yS + (int32_t)_hS)
+    yB = _yS + (int32_t)_hS;
+  if (xC >= xR || yC >= yB)
+    return;
+  bitmap += (int32_t)(yC - y) * w + (xC - x);
+  for (; yC < yB; yC++, bitmap += w) {
+    #if STRIP_RENDER_TT_BITS == 16
+    memcpy(_buffer + (int32_t)(yC - _yS) * _width + xC, bitmap,
+      (xR - xC) * 2);
+    #else
+    // Each run of equal pixels takes one palette lookup.
+    int16_t i = 0;
+    while (i < xR - xC) {
+      int16_t j = i + 1;
+      while (j < xR - xC && bitmap[j] == bitmap[i])
+        j++;
+      fill(xC + i, yC, j - i, 1, bitmap[i]);
+      i = j;
+    }
+    #endif
+  }
+}
+
+#if STRIP_RENDER_TT_BITS == 16
+/**************************************************************************/
+void StripRender_TT::drawMaskRow(const uint8_t* mask, int16_t x, int16_t y,
+    int16_t w, uint16_t color, uint16_t bg) {
+
+  // Limit the row to the clip rectangle and the strip.
+  int16_t xC = x, yC = y, wC = w, hC = 1;
+  if (!Clip_TT::clip(xC, yC, wC, hC) || yC < _yS ||
+      yC >= _yS + (int16_t)_hS)
+    return;
+  int32_t xR = (int32_t)xC + wC;
+  if (xC < 0)
+    xC = 0;
+  if (xR > _width)
+    xR = _width;
+  if (xC >= xR)
+    return;
+
+  // Expand the bits up to the first whole byte of the mask one at a time,
+  // and the rest with expandBits().
+  uint16_t* row = _buffer + (int32_t)(yC - _yS) * _width + x;
+  int16_t i = xC - x, iR = xR - x;
+  for (; (i & 7) != 0 && i < iR; i++)
+    row[i] = (mask[i >> 3] & (0x80 >> (i & 7))) ? color : bg;
+  if (i < iR)
+    TextRender_TT::expandBits(mask + (i >> 3), row + i, iR - i, color, bg);
+}
+#endif
+
+/**************************************************************************/
+void StripRender_TT::renderStrip(int16_t y, uint16_t h) {
+
+  _yS = y;
+  _hS = h;
+  fill(0, y, _width, h, _bgColor);
+
+  // Draw the background and the buttons clipped to the strip.
+  bool clipped = Clip_TT::push(0, y, _width, h);
+  if (_drawBackground != nullptr)
+    _drawBackground(this, y, h);
+  for (uint8_t i = 0; i < _numButtons; i++) {
+    Button_TT* b = _buttons[i];
+    int16_t bx, by;
+    uint16_t bw, bh;
+    b->getDrawnBounds(bx, by, bw, bh);
+    if (by >= y + (int16_t)h || (int32_t)by + bh <= y)
+      continue;
+    Adafruit_GFX* gfx = b->getGFX();
+    b->setGFX(this);
+    b->drawButton();
+    b->setGFX(gfx);
+  }
+  if (clipped)
+    Clip_TT::pop();
+
+  // Write the strip to the display.
+  #if STRIP_RENDER_TT_BITS == 16
+  #if TEXT_RENDER_TT_SPITFT
+  if (TextRender_TT::windowable(_gfx, 0, y, _width, h)) {
+    Adafruit_SPITFT* tft = (Adafruit_SPITFT*)_gfx;
+    tft->startWrite();
+    tft->setAddrWindow(0, y, _width, h);
+    tft->writePixels(_buffer, (uint32_t)_width * h);
+    tft->endWrite();
+    return;
+  }
+  #endif
+  Clip_TT::drawRGBBitmap(_gfx, 0, y, _buffer, _width, h);
+  #else
+  // Expand each row of indices to RGB565 pixels and write it.
+  #if TEXT_RENDER_TT_SPITFT
+  bool windowed = TextRender_TT::windowable(_gfx, 0, y, _width, h);
+  Adafruit_SPITFT* tft = (Adafruit_SPITFT*)_gfx;
+  if (windowed) {
+    tft->startWrite();
+    tft->setAddrWindow(0, y, _width, h);
+  }
+  #endif
+  const uint8_t* row = _buffer;
+  for (uint16_t i = 0; i < h; i++, row += _stride) {
+    #if STRIP_RENDER_TT_BITS == 8
+    Palette_TT::expand8(row, _row, _width);
+    #else
+    Palette_TT::expand4(row, _row, _width);
+    #endif
+    #if TEXT_RENDER_TT_SPITFT
+    if (windowed) {
+      tft->writePixels(_row, _width);
+      continue;
+    }
+    #endif
+    Clip_TT::drawRGBBitmap(_gfx, 0, y + i, _row, _width, 1);
+  }
+  #if TEXT_RENDER_TT_SPITFT
+  if (windowed)
+    tft->endWrite();
+  #endif
+  #endif
+}
+
+/**************************************************************************/
+bool StripRender_TT::render(int16_t y, uint16_t h) {
+
+  // The display's size may have changed with its rotation.
+  _width = _gfx->width();
+  _height = _gfx->height();
+  int32_t yB = (h == 0) ? _height : (int32_t)y + h;
+  if (y < 0)
+    y = 0;
+  if (yB > _height)
+    yB = _height;
+  if (y >= yB || _width <= 0)
+    return (true);
+
+  uint16_t rows = (_rows < yB - y) ? _rows : yB - y;
+  #if STRIP_RENDER_TT_BITS == 16
+  while ((_buffer = (uint16_t*)malloc((size_t)_width * rows * 2)) == nullptr)
+    if ((rows /= 2) == 0)
+      return (false);
+  #else
+  // The row of RGB565 pixels follows the rows of indices, which are padded to
+  // an even number of bytes to align it.
+  _stride = ((uint16_t)_width * STRIP_RENDER_TT_BITS + 15) / 16 * 2;
+  while ((_buffer = (uint8_t*)malloc((size_t)_stride * rows + _width * 2)) ==
+      nullptr)
+    if ((rows /= 2) == 0)
+      return (false);
+  _row = (uint16_t*)(_buffer + (size_t)_stride * rows);
+  #endif
+
+  TextRender_TT::setOffscreen(this);
+  for (; y < yB; y += rows)
+    renderStrip(y, (yB - y < rows) ? yB - y : rows);
+  TextRender_TT::setOffscreen(nullptr);
+  free(_buffer);
+  _buffer = nullptr;
+  return (true);
+}
+
+// -------------------------------------------------------------------------
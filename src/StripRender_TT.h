@@ -0,0 +1,320 @@
+/*
+  StripRender_TT.h - Defines C++ class StripRender_TT, which redraws a screen
+  of buttons one horizontal strip at a time, composing each strip in a small
+  RAM buffer and writing it to the display as a single bitmap.
+  Released into the public domain.
+
+
+  Software License Agreement (BSD License)
+
+  Copyright (c) 2023 Ted Toal
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  1. Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+  2. Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+  3. Neither the name of the copyright holders nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  Buttons drawn directly on a display are drawn one after another, so while
+  the screen is redrawn the display shows the background before the buttons,
+  and a button under another one before the one on top. A full-screen frame
+  buffer would avoid this, but a 320 x 240 display needs 150 KB for one.
+
+  A StripRender_TT object holds the buttons of a screen, registered with
+  registerButton() in the order in which they are drawn (bottom to top).
+  render() redraws the screen, or a band of its rows, in strips of a fixed
+  number of rows. Each strip is filled with the background color, then any
+  background drawing function given to the constructor is called to draw on
+  it, then each registered button that intersects the strip is drawn on it,
+  and the strip is written to the display with one drawRGBBitmap() call, or
+  through one address window if TEXT_RENDER_TT_SPITFT is 1 (see
+  TextRender_TT.h). Each display pixel is written once, with its final color.
+  Rows of text pixels are written into the strip buffer whole: the rows of
+  opaque text are expanded from bit masks straight into it, and rows of
+  anti-aliased text and glyph cache entries are copied into it.
+
+  The strip buffer, display width x strip rows x 2 bytes, is allocated from
+  the heap when render() is called and freed when it returns, so it uses RAM
+  only while the screen is being drawn. If it can't be allocated, the number
+  of rows is halved until it can. A 320-pixel-wide display with 16-row strips
+  needs 10 KB.
+
+  Set STRIP_RENDER_TT_BITS to 8 or 4 to hold palette indices (see
+  Palette_TT.h) in the strip buffer rather than RGB565 pixels, halving or
+  quartering its size (5 KB or 2.5 KB for the strips above, plus one row of
+  RGB565 pixels). Each color drawn on the strip is looked up in the palette
+  (the first 16 entries for 4 bits), and each row of indices is expanded back
+  to RGB565 pixels as the strip is written to the display. The colors of the
+  background and the buttons must then be in the palette.
+
+  To draw a button on the strip, the object sets the button's display object
+  (see Button_TT::setGFX()) to itself, an Adafruit_GFX that draws into the
+  strip buffer, and pushes a clip rectangle (see Clip_TT.h) for the strip, so
+  the parts of the button outside the strip are skipped. A button is thus
+  drawn once for each strip it intersects, and a tall button costs more than
+  a short one. Its display object is restored after it is drawn.
+
+  Buttons drawn with drawButton() or drawIfChanged() are still drawn directly
+  on the display as before.
+
+  Example:
+
+    StripRender_TT strips(lcd, 16, ILI9341_BLUE);
+    ...
+    strips.registerButton(btn_Temperature);
+    strips.registerButton(btn_Alarm);
+    ...
+    strips.render();
+*/
+#ifndef StripRender_TT_h
+#define StripRender_TT_h
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Button_TT.h>
+
+// Maximum number of registered buttons.
+#define STRIP_RENDER_TT_MAX_BUTTONS 20
+
+// Bits per pixel of the strip buffer: 16 for RGB565 pixels, or 8 or 4 for
+// palette indices.
+#define STRIP_RENDER_TT_BITS 16
+
+#if STRIP_RENDER_TT_BITS != 16
+#include <Palette_TT.h>
+#endif
+
+/**************************************************************************/
+/*!
+  @brief  A class that redraws the buttons of a screen in horizontal strips,
+          each composed in a RAM buffer and written to the display at once.
+          It is also the Adafruit_GFX object that draws into the buffer.
+*/
+/**************************************************************************/
+class StripRender_TT : public Adafruit_GFX {
+
+protected:
+
+  Adafruit_GFX* _gfx;         // The display.
+  uint16_t _rows;             // Number of rows in a strip.
+  uint16_t _bgColor;          // Background color.
+
+  // Function to draw the background of a strip, nullptr if none.
+  void (*_drawBackground)(Adafruit_GFX* gfx, int16_t y, uint16_t h);
+
+  // The registered buttons, in drawing order.
+  Button_TT* _buttons[STRIP_RENDER_TT_MAX_BUTTONS];
+  uint8_t _numButtons;
+
+  // The strip buffer, and the first row and number of rows of the strip now
+  // in it. With palette indices, _stride is the number of bytes per row and
+  // _row is a row of RGB565 pixels for writing a row to the display.
+  #if STRIP_RENDER_TT_BITS == 16
+  uint16_t* _buffer;
+  #else
+  uint8_t* _buffer;
+  uint16_t _stride;
+  uint16_t* _row;
+  #endif
+  int16_t _yS;
+  uint16_t _hS;
+
+  /**************************************************************************/
+  // Fill rectangle (x, y, w, h) of the strip with 'color', limited to the
+  // strip.
+  /**************************************************************************/
+  void fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+  /**************************************************************************/
+  // Compose the strip of h rows starting at row y in the buffer and write it
+  // to the display.
+  /**************************************************************************/
+  void renderStrip(int16_t y, uint16_t h);
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Constructor.
+    @param    gfx             The display.
+    @param    rows            Number of rows in a strip.
+    @param    bgColor         Color with which each strip is filled before
+                              anything is drawn on it.
+    @param    drawBackground  Function to call to draw more of the background
+                              on the strip gfx (covering rows y to y+h-1)
+                              before the buttons are drawn, nullptr if none.
+  */
+  /**************************************************************************/
+  StripRender_TT(Adafruit_GFX* gfx, uint16_t rows, uint16_t bgColor = 0,
+      void (*drawBackground)(Adafruit_GFX* gfx, int16_t y, uint16_t h) =
+      nullptr) : Adafruit_GFX(gfx->width(), gfx->height()) {
+    _gfx = gfx;
+    _rows = (rows > 0) ? rows : 1;
+    _bgColor = bgColor;
+    _drawBackground = drawBackground;
+    _numButtons = 0;
+    _buffer = nullptr;
+    #if STRIP_RENDER_TT_BITS != 16
+    _stride = 0;
+    _row = nullptr;
+    #endif
+    _yS = 0;
+    _hS = 0;
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the background color.
+    @param    bgColor   Color with which each strip is filled.
+  */
+  /**************************************************************************/
+  void setBgColor(uint16_t bgColor) { _bgColor = bgColor; }
+
+  /**************************************************************************/
+  /*!
+    @brief    Unregister all buttons.
+  */
+  /**************************************************************************/
+  void clear(void) { _numButtons = 0; }
+
+  /**************************************************************************/
+  /*!
+    @brief    Register a button, after the buttons already registered, so it
+              is drawn over them.
+    @param    button    The button to be registered.
+    @returns  true if successful or button is already registered, false if
+              the maximum number of buttons are registered.
+  */
+  /**************************************************************************/
+  bool registerButton(Button_TT& button);
+
+  /**************************************************************************/
+  /*!
+    @brief    Unregister a previously-registered button.
+    @param    button    The button to be unregistered.
+    @returns  true if successful, false if button was not registered.
+  */
+  /**************************************************************************/
+  bool unregisterButton(Button_TT& button);
+
+  /**************************************************************************/
+  /*!
+    @brief    Redraw a band of rows of the screen, strip by strip.
+    @param    y       First row to redraw.
+    @param    h       Number of rows to redraw, 0 for all rows from y to the
+                      bottom of the display.
+    @returns  true if redrawn, false if no strip buffer could be allocated.
+  */
+  /**************************************************************************/
+  bool render(int16_t y = 0, uint16_t h = 0);
+
+  /**************************************************************************/
+  /*!
+    @brief    Adafruit_GFX functions, which draw into the strip buffer, limited
+              to the strip being composed. Not for use outside render().
+  */
+  /**************************************************************************/
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    #if STRIP_RENDER_TT_BITS == 16
+    if (x >= 0 && x < _width && y >= _yS && y < _yS + (int16_t)_hS)
+      _buffer[(int32_t)(y - _yS) * _width + x] = color;
+    #else
+    fill(x, y, 1, 1, color);
+    #endif
+  }
+  void writePixel(int16_t x, int16_t y, uint16_t color) override {
+    drawPixel(x, y, color);
+  }
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+      uint16_t color) override {
+    fill(x, y, w, h, color);
+  }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h,
+      uint16_t color) override {
+    fill(x, y, 1, h, color);
+  }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w,
+      uint16_t color) override {
+    fill(x, y, w, 1, color);
+  }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h,
+      uint16_t color) override {
+    fill(x, y, 1, h, color);
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w,
+      uint16_t color) override {
+    fill(x, y, w, 1, color);
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+      uint16_t color) override {
+    fill(x, y, w, h, color);
+  }
+  void fillScreen(uint16_t color) override {
+    fill(0, _yS, _width, _hS, color);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Draw a rectangle of RGB565 pixels into the strip buffer, limited
+              to the strip and the clip rectangle (see Clip_TT.h), a row at a
+              time rather than a pixel at a time. Adafruit_GFX's
+              drawRGBBitmap() is not virtual, so this is called through a
+              StripRender_TT pointer, as TextRender_TT does. Not for use
+              outside render().
+    @param    x       Left edge of the rectangle.
+    @param    y       Top edge of the rectangle.
+    @param    bitmap  The w x h pixels, row by row.
+    @param    w       Width of the rectangle.
+    @param    h       Height of the rectangle.
+  */
+  /**************************************************************************/
+  using Adafruit_GFX::drawRGBBitmap;
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t* bitmap, int16_t w,
+    int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t* bitmap, int16_t w,
+      int16_t h) {
+    drawRGBBitmap(x, y, (const uint16_t*)bitmap, w, h);
+  }
+
+  #if STRIP_RENDER_TT_BITS == 16
+  /**************************************************************************/
+  /*!
+    @brief    Draw a row of 1-bit pixels into the strip buffer, limited to the
+              strip and the clip rectangle, expanding them into the buffer
+              with TextRender_TT::expandBits(). TextRender_TT draws the rows
+              of opaque text with this. Not for use outside render().
+    @param    mask    The 1-bit pixels, 8 per byte, most significant bit
+                      first.
+    @param    x       Left edge of the row.
+    @param    y       Row.
+    @param    w       Number of pixels.
+    @param    color   Pixel value for 1 bits.
+    @param    bg      Pixel value for 0 bits.
+  */
+  /**************************************************************************/
+  void drawMaskRow(const uint8_t* mask, int16_t x, int16_t y, int16_t w,
+    uint16_t color, uint16_t bg);
+  #endif
+};
+
+#endif // StripRender_TT_h
@@ -0,0 +1,813 @@
+/*
+  TextRender_TT.cpp - Defines functions of class TextRender_TT. Some of the code
+  here was copied from Adafruit_GFX.cpp, and the Adafruit Copyright is retained
+  here.
+
+
+  Copyright (c) 2013 Adafruit Industries.  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <Arduino.h>
+#include <TextRender_TT.h>
+#include <StripRender_TT.h>
+#include <pgmspace_GFX.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/**************************************************************************/
+StripRender_TT* TextRender_TT::_offscreen = nullptr;
+
+/**************************************************************************/
+bool TextRender_TT::windowable(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    int16_t w, int16_t h) {
+
+  #if TEXT_RENDER_TT_SPITFT
+  return (gfx != _offscreen && x >= 0 && y >= 0 && w > 0 && h > 0 &&
+    x + w <= gfx->width() && y + h <= gfx->height() &&
+    Clip_TT::contains(x, y, w, h));
+  #else
+  (void)gfx;
+  (void)x;
+  (void)y;
+  (void)w;
+  (void)h;
+  return (false);
+  #endif
+}
+
+/**************************************************************************/
+void TextRender_TT::drawGlyph(Adafruit_GFX* gfx, const uint8_t* bitmaps,
+    const GFXglyph* glyph, int16_t x, int16_t y, uint8_t sx, uint8_t sy,
+    uint16_t color) {
+
+  uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+  uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+  int16_t xL = x + (int8_t)pgm_read_byte(&glyph->xOffset) * sx;
+  int16_t yT = y + (int8_t)pgm_read_byte(&glyph->yOffset) * sy;
+  uint8_t xx, yy, bits = 0, bit = 0;
+
+  // Decode each row into runs of set pixels and draw each run as one span.
+  gfx->startWrite();
+  for (yy = 0; yy < h; yy++) {
+    int16_t yR = yT + yy * sy;
+    uint8_t runStart = 0;
+    bool inRun = false;
+    for (xx = 0; xx < w; xx++) {
+      if (!(bit++ & 7))
+        bits = pgm_read_byte(&bitmaps[bo++]);
+      if (bits & 0x80) {
+        if (!inRun) {
+          runStart = xx;
+          inRun = true;
+        }
+      } else if (inRun) {
+        drawSpan(gfx, xL + runStart * sx, yR, (xx - runStart) * sx, sy, color);
+        inRun = false;
+      }
+      bits <<= 1;
+    }
+    if (inRun)
+      drawSpan(gfx, xL + runStart * sx, yR, (w - runStart) * sx, sy, color);
+  }
+  gfx->endWrite();
+}
+
+/**************************************************************************/
+void TextRender_TT::drawGlyphRLE(Adafruit_GFX* gfx, const uint8_t* bitmaps,
+    const GFXglyph* glyph, int16_t x, int16_t y, uint8_t sx, uint8_t sy,
+    uint16_t color) {
+
+  const uint8_t* p = bitmaps + pgm_read_word(&glyph->bitmapOffset);
+  uint8_t h = pgm_read_byte(&glyph->height);
+  int16_t xL = x + (int8_t)pgm_read_byte(&glyph->xOffset) * sx;
+  int16_t yT = y + (int8_t)pgm_read_byte(&glyph->yOffset) * sy;
+
+  gfx->startWrite();
+  uint8_t row = 0;
+  while (row < h) {
+    // Read the row's span count and look past the spans for the repeat
+    // records that follow, so spans of identical rows are drawn together. A
+    // repeat record where a span record is expected ends the glyph.
+    uint8_t N = pgm_read_byte(p++);
+    if (N & GFX_TT_RLE_REPEAT)
+      break;
+    const uint8_t* spans = p;
+    p += 2 * N;
+    uint16_t rows = 1;
+    while (row + rows < h) {
+      uint8_t R = pgm_read_byte(p);
+      if (!(R & GFX_TT_RLE_REPEAT))
+        break;
+      rows += R - (GFX_TT_RLE_REPEAT - 1);
+      p++;
+    }
+    if (rows > h - row)
+      rows = h - row;
+
+    int16_t xs = 0;
+    int16_t yR = yT + row * sy;
+    int16_t hR = rows * sy;
+    for (uint8_t i = 0; i < N; i++) {
+      xs += pgm_read_byte(spans++);
+      uint8_t len = pgm_read_byte(spans++);
+      drawSpan(gfx, xL + xs * sx, yR, len * sx, hR, color);
+      xs += len;
+    }
+    row += rows;
+  }
+  gfx->endWrite();
+}
+
+/**************************************************************************/
+uint16_t TextRender_TT::_lut[16];
+uint16_t TextRender_TT::_lutColor;
+uint16_t TextRender_TT::_lutBg;
+uint8_t TextRender_TT::_lutLevels = 0;
+uint16_t* TextRender_TT::_pixelRow = nullptr;
+uint16_t TextRender_TT::_pixelRowBytes = 0;
+
+/**************************************************************************/
+void TextRender_TT::makeBlendLUT(uint16_t* lut, uint8_t n, uint16_t color,
+    uint16_t bg) {
+
+  uint8_t r1 = color >> 11, g1 = (color >> 5) & 0x3F, b1 = color & 0x1F;
+  uint8_t r0 = bg >> 11, g0 = (bg >> 5) & 0x3F, b0 = bg & 0x1F;
+  uint8_t m = n - 1;
+  for (uint8_t i = 0; i < n; i++) {
+    // Blend each color component, rounding to nearest.
+    uint16_t r = (r1 * i + r0 * (m - i) + m / 2) / m;
+    uint16_t g = (g1 * i + g0 * (m - i) + m / 2) / m;
+    uint16_t b = (b1 * i + b0 * (m - i) + m / 2) / m;
+    lut[i] = (r << 11) | (g << 5) | b;
+  }
+}
+
+/**************************************************************************/
+const uint16_t* TextRender_TT::blendLUT(uint8_t levels, uint16_t color,
+    uint16_t bg) {
+
+  if (_lutLevels != levels || _lutColor != color || _lutBg != bg) {
+    makeBlendLUT(_lut, levels, color, bg);
+    _lutLevels = levels;
+    _lutColor = color;
+    _lutBg = bg;
+  }
+  return (_lut);
+}
+
+/**************************************************************************/
+void TextRender_TT::drawGlyphGray(Adafruit_GFX* gfx, const uint8_t* bitmaps,
+    const GFXglyph* glyph, uint8_t bpp, int16_t x, int16_t y, uint8_t sx,
+    uint8_t sy, const uint16_t* lut, uint8_t minLevel) {
+
+  const uint8_t* p = bitmaps + pgm_read_word(&glyph->bitmapOffset);
+  uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+  int16_t xL = x + (int8_t)pgm_read_byte(&glyph->xOffset) * sx;
+  int16_t yT = y + (int8_t)pgm_read_byte(&glyph->yOffset) * sy;
+  uint8_t bits = 0, nBits = 0;
+
+  // Decode each row into runs of pixels with the same level and draw each
+  // run of a drawn level as one span.
+  gfx->startWrite();
+  for (uint8_t yy = 0; yy < h; yy++) {
+    int16_t yR = yT + yy * sy;
+    uint8_t runStart = 0, runLevel = 0;
+    for (uint8_t xx = 0; xx < w; xx++) {
+      if (nBits == 0) {
+        bits = pgm_read_byte(p++);
+        nBits = 8;
+      }
+      uint8_t level = bits >> (8 - bpp);
+      bits <<= bpp;
+      nBits -= bpp;
+      if (level < minLevel)
+        level = 0;
+      if (level != runLevel) {
+        if (runLevel)
+          drawSpan(gfx, xL + runStart * sx, yR, (xx - runStart) * sx, sy,
+            lut[runLevel]);
+        runStart = xx;
+        runLevel = level;
+      }
+    }
+    if (runLevel)
+      drawSpan(gfx, xL + runStart * sx, yR, (w - runStart) * sx, sy,
+        lut[runLevel]);
+  }
+  gfx->endWrite();
+}
+
+
+/**************************************************************************/
+void TextRender_TT::drawChar(Adafruit_GFX* gfx, const Font_TT::FontParams &fp,
+    int16_t &x, int16_t &y, uint16_t c, uint16_t color, uint16_t bg) {
+
+  uint8_t sx = fp.sx, sy = fp.sy;
+
+  if (c == '\n') {
+    x = 0;
+    y += sy * fp.yAdvance;
+    return;
+  }
+  if (c == '\r')
+    return;
+
+  if (Font_TT::builtIn(fp)) {
+    // Built-in font, the cursor is the top-left corner of the character cell.
+    if (!Clip_TT::rejects(x, y, sx * 6, sy * 8)) {
+      ClipGFX_TT clipped(gfx);
+      Adafruit_GFX* g = Clip_TT::isClipped() ? &clipped : gfx;
+      g->setFont(nullptr);
+      g->drawChar(x, y, (unsigned char)c, color, color, sx, sy);
+    }
+    x += sx * 6;
+    return;
+  }
+
+  const GFXglyph* glyph = Font_TT::findGlyph(c, fp);
+  if (glyph) {
+    // A glyph lying outside the clip rectangle is not decoded.
+    uint8_t gw = pgm_read_byte(&glyph->width);
+    uint8_t gh = pgm_read_byte(&glyph->height);
+    int16_t gx = x + (int8_t)pgm_read_byte(&glyph->xOffset) * sx;
+    int16_t gy = y + (int8_t)pgm_read_byte(&glyph->yOffset) * sy;
+    if (gw > 0 && gh > 0 && !Clip_TT::rejects(gx, gy, gw * sx, gh * sy)) {
+      uint8_t bpp = grayBits(fp.bitmapFormat);
+      if (bpp) {
+        // With no background to blend with, the table is all 'color' and
+        // pixels less than half covered are not drawn.
+        uint8_t levels = 1 << bpp;
+        drawGlyphGray(gfx, Font_TT::glyphBitmaps(fp, glyph), glyph, bpp, x, y,
+          sx, sy, blendLUT(levels, color, bg), (bg == color) ? levels / 2 : 1);
+      } else if (fp.bitmapFormat == GFX_TT_BITMAP_RLE)
+        drawGlyphRLE(gfx, Font_TT::glyphBitmaps(fp, glyph), glyph, x, y, sx, sy,
+          color);
+      else
+        drawGlyph(gfx, Font_TT::glyphBitmaps(fp, glyph), glyph, x, y, sx, sy,
+          color);
+    }
+    x += (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)sx;
+  }
+}
+
+/**************************************************************************/
+void TextRender_TT::drawText(Adafruit_GFX* gfx, Font_TT* f, int16_t &x,
+    int16_t &y, const char* str, uint16_t color, uint16_t bg) {
+
+  Font_TT::FontParams fp;
+  f->loadFontParams(fp);
+  f->prefetch(str);
+  uint16_t c;
+  while ((c = Font_TT::nextChar(str, false, fp.utf8)))
+    drawChar(gfx, fp, x, y, c, color, bg);
+}
+
+/**************************************************************************/
+void TextRender_TT::drawChar(Adafruit_GFX* gfx, Font_TT* f, int16_t &x,
+    int16_t &y, uint16_t c, uint16_t color, uint16_t bg) {
+
+  Font_TT::FontParams fp;
+  f->loadFontParams(fp);
+  drawChar(gfx, fp, x, y, c, color, bg);
+}
+
+/**************************************************************************/
+void TextRender_TT::setMaskBits(uint8_t* mask, int16_t w, int16_t x,
+    int16_t n) {
+
+  if (x < 0) {
+    n += x;
+    x = 0;
+  }
+  if (x + n > w)
+    n = w - x;
+  for (; n > 0; n--, x++)
+    mask[x >> 3] |= 0x80 >> (x & 7);
+}
+
+/**************************************************************************/
+void TextRender_TT::maskGlyphRow(uint8_t* mask, int16_t w,
+    const uint8_t* bitmaps, const GFXglyph* glyph, uint8_t bitmapFormat,
+    int16_t x, uint8_t row, uint8_t sx) {
+
+  uint8_t gw = pgm_read_byte(&glyph->width);
+  const uint8_t* p = bitmaps + pgm_read_word(&glyph->bitmapOffset);
+
+  if (bitmapFormat == GFX_TT_BITMAP_RLE) {
+    // Scan the row records to find the one for 'row'. A repeat record refers
+    // back to the last span record.
+    const uint8_t* rec = p;
+    uint8_t r = 0;
+    while (true) {
+      uint8_t N = pgm_read_byte(p);
+      if (N & GFX_TT_RLE_REPEAT) {
+        r += N - (GFX_TT_RLE_REPEAT - 1);
+        if (row < r)
+          break;
+        p++;
+      } else {
+        rec = p;
+        if (r == row)
+          break;
+        r++;
+        p += 1 + 2 * N;
+      }
+    }
+    uint8_t N = pgm_read_byte(rec++);
+    int16_t xs = 0;
+    for (uint8_t i = 0; i < N; i++) {
+      xs += pgm_read_byte(rec++);
+      uint8_t len = pgm_read_byte(rec++);
+      setMaskBits(mask, w, x + xs * sx, len * sx);
+      xs += len;
+    }
+    return;
+  }
+
+  uint16_t bit = row * gw;
+  p += bit >> 3;
+  uint8_t bits = pgm_read_byte(p++) << (bit & 7);
+  bit &= 7;
+  uint8_t runStart = 0;
+  bool inRun = false;
+  for (uint8_t xx = 0; xx < gw; xx++) {
+    if (bits & 0x80) {
+      if (!inRun) {
+        runStart = xx;
+        inRun = true;
+      }
+    } else if (inRun) {
+      setMaskBits(mask, w, x + runStart * sx, (xx - runStart) * sx);
+      inRun = false;
+    }
+    bits <<= 1;
+    if (!(++bit & 7) && xx + 1 < gw)
+      bits = pgm_read_byte(p++);
+  }
+  if (inRun)
+    setMaskBits(mask, w, x + runStart * sx, (gw - runStart) * sx);
+}
+
+/**************************************************************************/
+void TextRender_TT::drawMaskRow(Adafruit_GFX* gfx, bool windowed,
+    const uint8_t* mask, int16_t x, int16_t y, int16_t w, uint16_t color,
+    uint16_t bg) {
+
+  #if !TEXT_RENDER_TT_SPITFT
+  (void)windowed;
+  #endif
+  #if STRIP_RENDER_TT_BITS == 16
+  // A strip buffer holds RGB565 pixels, so expand the row straight into it.
+  if (gfx == _offscreen) {
+    _offscreen->drawMaskRow(mask, x, y, w, color, bg);
+    return;
+  }
+  #endif
+  int16_t i = 0;
+  while (i < w) {
+    bool on = mask[i >> 3] & (0x80 >> (i & 7));
+    uint8_t full = on ? 0xFF : 0x00;
+    int16_t j = i + 1;
+    while (j < w) {
+      if (!(j & 7) && j + 8 <= w && mask[j >> 3] == full)
+        j += 8;
+      else if (((mask[j >> 3] & (0x80 >> (j & 7))) != 0) == on)
+        j++;
+      else
+        break;
+    }
+    uint16_t runColor = on ? color : bg;
+    #if TEXT_RENDER_TT_SPITFT
+    if (windowed)
+      ((Adafruit_SPITFT*)gfx)->writeColor(runColor, j - i);
+    else
+      Clip_TT::writeFastHLine(gfx, x + i, y, j - i, runColor);
+    #else
+    Clip_TT::writeFastHLine(gfx, x + i, y, j - i, runColor);
+    #endif
+    i = j;
+  }
+}
+
+/**************************************************************************/
+void TextRender_TT::grayGlyphRow(uint16_t* pixels, int16_t w,
+    const uint8_t* bitmaps, const GFXglyph* glyph, uint8_t bpp, int16_t x,
+    uint8_t row, uint8_t sx, const uint16_t* lut) {
+
+  uint8_t gw = pgm_read_byte(&glyph->width);
+  uint32_t bit = (uint32_t)row * gw * bpp;
+  const uint8_t* p = bitmaps + pgm_read_word(&glyph->bitmapOffset) +
+    (bit >> 3);
+  uint8_t bits = pgm_read_byte(p++) << (bit & 7);
+  uint8_t nBits = 8 - (bit & 7);
+  for (uint8_t xx = 0; xx < gw; xx++) {
+    if (nBits == 0) {
+      bits = pgm_read_byte(p++);
+      nBits = 8;
+    }
+    uint8_t level = bits >> (8 - bpp);
+    bits <<= bpp;
+    nBits -= bpp;
+    if (level) {
+      int16_t i = x + xx * sx, n = sx;
+      if (i < 0) {
+        n += i;
+        i = 0;
+      }
+      for (; n > 0 && i < w; n--, i++)
+        pixels[i] = lut[level];
+    }
+  }
+}
+
+/**************************************************************************/
+void TextRender_TT::drawPixelRow(Adafruit_GFX* gfx, bool windowed,
+    uint16_t* pixels, int16_t x, int16_t y, int16_t w) {
+
+  #if TEXT_RENDER_TT_SPITFT
+  if (windowed) {
+    ((Adafruit_SPITFT*)gfx)->writePixels(pixels, w);
+    return;
+  }
+  #else
+  (void)windowed;
+  #endif
+  if (gfx == _offscreen) {
+    _offscreen->drawRGBBitmap(x, y, pixels, w, 1);
+    return;
+  }
+  int16_t i = 0;
+  while (i < w) {
+    int16_t j = i + 1;
+    while (j < w && pixels[j] == pixels[i])
+      j++;
+    Clip_TT::writeFastHLine(gfx, x + i, y, j - i, pixels[i]);
+    i = j;
+  }
+}
+
+/**************************************************************************/
+void TextRender_TT::drawTextOpaque(Adafruit_GFX* gfx, Font_TT* f, int16_t &x,
+    int16_t &y, const char* str, uint16_t color, uint16_t bg, int16_t xL,
+    int16_t yT, int16_t w, int16_t h) {
+
+  Font_TT::FontParams fp;
+  f->loadFontParams(fp);
+
+  // Each row is built in 'mask', a bit mask for 1-bit fonts, or an array of
+  // RGB565 pixels for anti-aliased fonts, which is kept for the next call
+  // (see _pixelRow).
+  uint8_t bpp = grayBits(fp.bitmapFormat);
+  uint8_t M[TEXT_RENDER_TT_MASK_BYTES];
+  uint8_t* mask = M;
+  uint16_t nBytes = (w > 0) ? (bpp ? w * 2 : (w + 7) / 8) : 0;
+  if (bpp) {
+    if (nBytes > _pixelRowBytes) {
+      free(_pixelRow);
+      _pixelRow = (uint16_t*)malloc(nBytes);
+      _pixelRowBytes = (_pixelRow != nullptr) ? nBytes : 0;
+    }
+    mask = (uint8_t*)_pixelRow;
+  } else if (nBytes > sizeof(M))
+    mask = (uint8_t*)malloc(nBytes);
+
+  // The built-in font has no glyph bitmaps to mask, so fill and then draw.
+  if (Font_TT::builtIn(fp) || mask == nullptr) {
+    if (!bpp && mask != M)
+      free(mask);
+    Clip_TT::fillRect(gfx, xL, yT, w, h, bg);
+    drawText(gfx, f, x, y, str, color, bg);
+    return;
+  }
+  const uint16_t* lut = bpp ? blendLUT(1 << bpp, color, bg) : nullptr;
+  f->prefetch(str);
+
+  // Get the rows containing text pixels and the final cursor position.
+  int16_t tL, tT, xF, yF;
+  uint16_t tw, th;
+  f->getTextBounds(str, false, fp, x, y, &tL, &tT, &tw, &th, &xF, &yF);
+
+  uint8_t sx = fp.sx, sy = fp.sy;
+  gfx->startWrite();
+  // The address window must lie on the display and inside the clip rectangle,
+  // else draw each run clipped.
+  bool windowed = windowable(gfx, xL, yT, w, h);
+  #if TEXT_RENDER_TT_SPITFT
+  if (windowed)
+    ((Adafruit_SPITFT*)gfx)->setAddrWindow(xL, yT, w, h);
+  #endif
+  for (int16_t yy = yT; yy < yT + h; yy++) {
+    if (!windowed && Clip_TT::rejects(xL, yy, w, 1))
+      continue;
+    if (bpp) {
+      for (int16_t i = 0; i < w; i++)
+        ((uint16_t*)mask)[i] = bg;
+    } else
+      memset(mask, 0, nBytes);
+    if (yy >= tT && yy < tT + (int16_t)th) {
+      int16_t xC = x, yC = y;
+      const char* s = str;
+      uint16_t c;
+      while ((c = Font_TT::nextChar(s, false, fp.utf8))) {
+        if (c == '\n') {
+          xC = 0;
+          yC += sy * fp.yAdvance;
+          continue;
+        }
+        if (c == '\r')
+          continue;
+        const GFXglyph* glyph = Font_TT::findGlyph(c, fp);
+        if (!glyph)
+          continue;
+        int16_t gy = yC + (int8_t)pgm_read_byte(&glyph->yOffset) * sy;
+        int16_t gh = pgm_read_byte(&glyph->height) * sy;
+        if (yy >= gy && yy < gy + gh) {
+          int16_t gx = xC + (int8_t)pgm_read_byte(&glyph->xOffset) * sx - xL;
+          if (bpp)
+            grayGlyphRow((uint16_t*)mask, w, Font_TT::glyphBitmaps(fp, glyph),
+              glyph, bpp, gx, (yy - gy) / sy, sx, lut);
+          else
+            maskGlyphRow(mask, w, Font_TT::glyphBitmaps(fp, glyph), glyph,
+              fp.bitmapFormat, gx, (yy - gy) / sy, sx);
+        }
+        xC += (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)sx;
+      }
+    }
+    if (bpp)
+      drawPixelRow(gfx, windowed, (uint16_t*)mask, xL, yy, w);
+    else
+      drawMaskRow(gfx, windowed, mask, xL, yy, w, color, bg);
+  }
+  gfx->endWrite();
+
+  if (!bpp && mask != M)
+    free(mask);
+  x = xF;
+  y = yF;
+}
+
+/**************************************************************************/
+void TextRender_TT::expandBits(const uint8_t* bits, uint16_t* pixels,
+    int16_t w, uint16_t color, uint16_t bg) {
+
+  int16_t i = 0;
+
+  // Vector versions: each pixel lane is set to all 1's if its bit is set by
+  // comparing the lane's bit after masking it, then selects color or bg.
+  #if defined(__AVX2__)
+  const __m256i sel256 = _mm256_setr_epi16(0x80, 0x40, 0x20, 0x10, 0x08, 0x04,
+    0x02, 0x01, 0x8000, 0x4000, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x0100);
+  const __m256i fg256 = _mm256_set1_epi16(color);
+  const __m256i bg256 = _mm256_set1_epi16(bg);
+  for (; i + 16 <= w; i += 16) {
+    __m256i v = _mm256_set1_epi16(bits[i >> 3] | (bits[(i >> 3) + 1] << 8));
+    __m256i m = _mm256_cmpeq_epi16(_mm256_and_si256(v, sel256), sel256);
+    _mm256_storeu_si256((__m256i*)(pixels + i), _mm256_or_si256(
+      _mm256_and_si256(m, fg256), _mm256_andnot_si256(m, bg256)));
+  }
+  #endif
+  #if defined(__SSE2__)
+  const __m128i sel = _mm_setr_epi16(0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02,
+    0x01);
+  const __m128i fg128 = _mm_set1_epi16(color);
+  const __m128i bg128 = _mm_set1_epi16(bg);
+  for (; i + 8 <= w; i += 8) {
+    __m128i v = _mm_set1_epi16(bits[i >> 3]);
+    __m128i m = _mm_cmpeq_epi16(_mm_and_si128(v, sel), sel);
+    _mm_storeu_si128((__m128i*)(pixels + i), _mm_or_si128(
+      _mm_and_si128(m, fg128), _mm_andnot_si128(m, bg128)));
+  }
+  #elif defined(__ARM_NEON)
+  const uint16_t selBits[8] = { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 };
+  const uint16x8_t sel = vld1q_u16(selBits);
+  const uint16x8_t fg128 = vdupq_n_u16(color);
+  const uint16x8_t bg128 = vdupq_n_u16(bg);
+  for (; i + 8 <= w; i += 8) {
+    uint16x8_t m = vtstq_u16(vdupq_n_u16(bits[i >> 3]), sel);
+    vst1q_u16(pixels + i, vbslq_u16(m, fg128, bg128));
+  }
+  #endif
+
+  // Scalar version: look up each pair of bits in a table of the four possible
+  // pixel pairs and copy the pair, 8 pixels per byte of bits.
+  uint16_t pairs[4][2] = {
+    { bg, bg }, { bg, color }, { color, bg }, { color, color }
+  };
+  for (; i + 8 <= w; i += 8) {
+    uint8_t b = bits[i >> 3];
+    memcpy(pixels + i, pairs[b >> 6], 4);
+    memcpy(pixels + i + 2, pairs[(b >> 4) & 3], 4);
+    memcpy(pixels + i + 4, pairs[(b >> 2) & 3], 4);
+    memcpy(pixels + i + 6, pairs[b & 3], 4);
+  }
+  for (; i < w; i++)
+    pixels[i] = (bits[i >> 3] & (0x80 >> (i & 7))) ? color : bg;
+}
+
+/**************************************************************************/
+void TextRender_TT::drawPixelBlock(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    uint16_t* pixels, int16_t w, int16_t h) {
+
+  #if TEXT_RENDER_TT_SPITFT
+  if (windowable(gfx, x, y, w, h)) {
+    Adafruit_SPITFT* tft = (Adafruit_SPITFT*)gfx;
+    tft->startWrite();
+    tft->setAddrWindow(x, y, w, h);
+    tft->writePixels(pixels, (uint32_t)w * h);
+    tft->endWrite();
+    return;
+  }
+  #endif
+  if (gfx == _offscreen)
+    _offscreen->drawRGBBitmap(x, y, pixels, w, h);
+  else
+    Clip_TT::drawRGBBitmap(gfx, x, y, pixels, w, h);
+}
+
+#if GLYPH_CACHE_TT_INDEXED
+/**************************************************************************/
+void TextRender_TT::drawLevelBlock(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    const uint8_t* levels, int16_t w, int16_t h, const uint16_t* lut,
+    uint16_t* pixels) {
+
+  gfx->startWrite();
+  bool windowed = windowable(gfx, x, y, w, h);
+  #if TEXT_RENDER_TT_SPITFT
+  if (windowed)
+    ((Adafruit_SPITFT*)gfx)->setAddrWindow(x, y, w, h);
+  #endif
+  for (int16_t yy = y; yy < y + h; yy++, levels += w) {
+    if (!windowed && Clip_TT::rejects(x, yy, w, 1))
+      continue;
+    for (int16_t i = 0; i < w; i++)
+      pixels[i] = lut[levels[i]];
+    drawPixelRow(gfx, windowed, pixels, x, yy, w);
+  }
+  gfx->endWrite();
+}
+#endif
+
+/**************************************************************************/
+void TextRender_TT::drawTextCached(Adafruit_GFX* gfx, Font_TT* f,
+    GlyphCache_TT* cache, int16_t &x, int16_t &y, const char* str,
+    uint16_t color, uint16_t bg) {
+
+  Font_TT::FontParams fp;
+  f->loadFontParams(fp);
+  uint8_t sx = fp.sx, sy = fp.sy;
+
+  // The built-in font draws its own opaque 6 x 8 character cells.
+  if (Font_TT::builtIn(fp)) {
+    uint16_t c;
+    ClipGFX_TT clipped(gfx);
+    Adafruit_GFX* g = Clip_TT::isClipped() ? &clipped : gfx;
+    g->setFont(nullptr);
+    while ((c = Font_TT::nextChar(str, false, fp.utf8))) {
+      if (c == '\n') {
+        x = 0;
+        y += sy * fp.yAdvance;
+      } else if (c != '\r') {
+        if (!Clip_TT::rejects(x, y, sx * 6, sy * 8))
+          g->drawChar(x, y, (unsigned char)c, color, bg, sx, sy);
+        x += sx * 6;
+      }
+    }
+    return;
+  }
+
+  int16_t dY;
+  uint16_t h;
+  cache->getFontExtent(f, dY, h);
+  uint8_t mask[TEXT_RENDER_TT_MASK_BYTES];
+  uint8_t bpp = grayBits(fp.bitmapFormat);
+  const uint16_t* lut = bpp ? blendLUT(1 << bpp, color, bg) : nullptr;
+
+  // Cells are built in RGB565 colors, or with GLYPH_CACHE_TT_INDEXED, in
+  // coverage levels (the level table and colors 0 and 1 below) in 'row' and
+  // then stored as bytes, to be drawn through 'lut'.
+  #if GLYPH_CACHE_TT_INDEXED
+  static const uint16_t levels[16] =
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+  uint16_t row[GLYPH_CACHE_TT_MAX_WIDTH];
+  uint16_t lut2[2] = { bg, color };
+  if (!bpp)
+    lut = lut2;
+  const uint16_t* cellLUT = levels;
+  uint16_t cellColor = 1, cellBg = 0;
+  #else
+  const uint16_t* cellLUT = lut;
+  uint16_t cellColor = color, cellBg = bg;
+  #endif
+
+  const void* font =
+    fp.stream ? (const void*)fp.stream : (const void*)fp.glyphs;
+  f->prefetch(str);
+  uint16_t c;
+  const char* s = str;
+  while ((c = Font_TT::nextChar(str, false, fp.utf8))) {
+    const char* s1 = s;
+    s = str;
+    if (c == '\n' || c == '\r') {
+      drawChar(gfx, fp, x, y, c, color, color);
+      continue;
+    }
+    const GFXglyph* glyph = Font_TT::findGlyph(c, fp);
+    if (!glyph)
+      continue;
+    int16_t w = (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)sx;
+    int16_t yT = y + dY;
+    if (Clip_TT::rejects(x, yT, w, h)) {
+      // The cell lies outside the clip rectangle.
+      x += w;
+      continue;
+    }
+    uint16_t index = Font_TT::glyphIndex(fp, glyph);
+
+    // Look up the cell, expanding it into a new cache entry if not found.
+    GlyphCachePixel_TT* pixels =
+      cache->find(font, index, sx, sy, color, bg, w, h);
+    bool cacheable = bpp || (w + 7) / 8 <= (int16_t)sizeof(mask);
+    #if GLYPH_CACHE_TT_INDEXED
+    cacheable = cacheable && w <= GLYPH_CACHE_TT_MAX_WIDTH;
+    #endif
+    if (!pixels && cacheable) {
+      pixels = cache->add(font, index, sx, sy, color, bg, w, h);
+      if (pixels) {
+        // (gx, gy) is the top left of the glyph within the cell.
+        int16_t gx = (int8_t)pgm_read_byte(&glyph->xOffset) * sx;
+        int16_t gy = (int8_t)pgm_read_byte(&glyph->yOffset) * sy - dY;
+        int16_t gh = pgm_read_byte(&glyph->height) * sy;
+        GlyphCachePixel_TT* p = pixels;
+        for (int16_t yy = 0; yy < (int16_t)h; yy++, p += w) {
+          #if GLYPH_CACHE_TT_INDEXED
+          uint16_t* q = row;
+          #else
+          uint16_t* q = p;
+          #endif
+          bool inGlyph = yy >= gy && yy < gy + gh;
+          if (bpp) {
+            // Anti-aliased rows are built directly as pixels.
+            for (int16_t i = 0; i < w; i++)
+              q[i] = cellBg;
+            if (inGlyph)
+              grayGlyphRow(q, w, Font_TT::glyphBitmaps(fp, glyph), glyph, bpp,
+                gx, (yy - gy) / sy, sx, cellLUT);
+          } else {
+            memset(mask, 0, (w + 7) / 8);
+            if (inGlyph)
+              maskGlyphRow(mask, w, Font_TT::glyphBitmaps(fp, glyph), glyph,
+                fp.bitmapFormat, gx, (yy - gy) / sy, sx);
+            expandBits(mask, q, w, cellColor, cellBg);
+          }
+          #if GLYPH_CACHE_TT_INDEXED
+          for (int16_t i = 0; i < w; i++)
+            p[i] = (uint8_t)q[i];
+          #endif
+        }
+      }
+    }
+
+    if (pixels) {
+      #if GLYPH_CACHE_TT_INDEXED
+      drawLevelBlock(gfx, x, yT, pixels, w, h, lut, row);
+      #else
+      drawPixelBlock(gfx, x, yT, pixels, w, h);
+      #endif
+      x += w;
+    } else {
+      // The cell can't be cached, draw it directly.
+      char S[5];
+      uint8_t n = s - s1;
+      memcpy(S, s1, n);
+      S[n] = 0;
+      drawTextOpaque(gfx, f, x, y, S, color, bg, x, yT, w, h);
+    }
+  }
+}
+
+// -------------------------------------------------------------------------
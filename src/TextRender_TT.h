@@ -0,0 +1,437 @@
+/*
+  TextRender_TT.h - Defines C++ class TextRender_TT, which draws text on a pixel
+  display using the fonts supported by class Font_TT, without using
+  Adafruit_GFX::print(). Some of the code here was copied from Adafruit_GFX.cpp,
+  and the Adafruit Copyright is retained here.
+
+
+  Copyright (c) 2013 Adafruit Industries.  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+
+
+  Details:
+
+  Adafruit_GFX::print() can only draw the built-in font and standard GFXfont
+  fonts whose characters are one range of 8-bit character codes. This class
+  draws all fonts supported by class Font_TT, including GFXfont_TT fonts with
+  sparse ranges of Unicode code points, whose strings are decoded as UTF-8.
+
+  It is also faster than Adafruit_GFX::print(), which draws a GFXfont glyph
+  with one writePixel() call per set pixel, or one writeFillRect() call per
+  set pixel for magnified text. This class decodes each glyph row into runs of
+  set pixels and draws each run with a single writeFastHLine() call, or a
+  single writeFillRect() call for magnified text. The built-in font is drawn
+  using Adafruit_GFX::drawChar(), to avoid a second copy of its table.
+
+  Text is drawn with the cursor (x,y) at the start of the text baseline, just
+  like Adafruit_GFX::print() using a GFXfont font, and the cursor is advanced
+  past the drawn text. Text wrapping is not supported.
+
+  Adafruit_GFX draws an opaque text background only for the built-in font, so
+  text in a GFXfont font must be erased by filling its area before drawing new
+  text, which flickers and writes every text pixel twice. drawTextOpaque()
+  instead draws a rectangle containing the text in one top-to-bottom pass,
+  writing each pixel once with either the text color or the background color.
+  Each row of the rectangle is built as a bit mask from the glyph rows that
+  cross it, then drawn as alternating runs of the two colors. If the display
+  is an Adafruit_SPITFT display (most SPI TFT displays), set the constant
+  TEXT_RENDER_TT_SPITFT below to 1, and the rectangle is then drawn through a
+  single address window using writeColor().
+
+  drawTextCached() also draws text with an opaque background, but character
+  by character, each character cell being expanded into RGB565 pixels once
+  and saved in a GlyphCache_TT, then drawn from the cache as a single block
+  (with one address window and one writePixels() call on an Adafruit_SPITFT
+  display if TEXT_RENDER_TT_SPITFT is 1, else with drawRGBBitmap()).
+
+  Anti-aliased fonts (GFXfont_TT fonts with GFX_TT_BITMAP_GRAY2 or
+  GFX_TT_BITMAP_GRAY4 bitmaps, see GFXfont_TT.h) are drawn by blending the text
+  color with the background color. Rather than blending each pixel, a table
+  of the 4 or 16 blended colors is computed for the (color, bg) pair, and
+  kept until a different pair is used, so each pixel is a table lookup. The
+  opaque functions blend with their background color. drawText() and
+  drawChar() blend with their 'bg' argument if it is given and differs from
+  the text color (for example a button's fill color), drawing only pixels
+  that are at least partly covered; otherwise they draw the pixels that are
+  at least half covered in the text color.
+
+  All functions are static, there is no need to create an instance of the
+  class.
+*/
+#ifndef TextRender_TT_h
+#define TextRender_TT_h
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Font_TT.h>
+#include <GlyphCache_TT.h>
+#include <Clip_TT.h>
+
+// Set this to 1 if all displays passed to drawTextOpaque() are derived from
+// class Adafruit_SPITFT, to draw the opaque text rectangle through a single
+// address window.
+#define TEXT_RENDER_TT_SPITFT 0
+
+#if TEXT_RENDER_TT_SPITFT
+#include <Adafruit_SPITFT.h>
+#endif
+
+// Size of the row mask buffer of drawTextOpaque() for 1-bit fonts, kept on the
+// stack. Wider rectangles allocate the buffer from the heap.
+#define TEXT_RENDER_TT_MASK_BYTES 40
+
+class StripRender_TT;
+
+/**************************************************************************/
+/*!
+  @brief  A class with functions for drawing text on a pixel display using a
+          Font_TT font.
+*/
+/**************************************************************************/
+class TextRender_TT {
+
+protected:
+
+  // Strip renderer whose strip buffer is being drawn on, set by
+  // setOffscreen(), nullptr if none.
+  static StripRender_TT* _offscreen;
+
+  /**************************************************************************/
+  // Draw a run of set glyph pixels, w pixels wide and h pixels high, as one
+  // horizontal line or one filled rectangle.
+  /**************************************************************************/
+  static void drawSpan(Adafruit_GFX* gfx, int16_t x, int16_t y, int16_t w,
+      int16_t h, uint16_t color) {
+    if (h == 1)
+      Clip_TT::writeFastHLine(gfx, x, y, w, color);
+    else
+      Clip_TT::writeFillRect(gfx, x, y, w, h, color);
+  }
+
+  /**************************************************************************/
+  // Draw one glyph of a GFXfont or GFXfont_TT font with its cursor position at
+  // (x,y), magnified by (sx,sy). Each row of the glyph is decoded into runs of
+  // set pixels, and each run is drawn as a single span, a rectangle when
+  // magnified, rather than drawing each pixel.
+  /**************************************************************************/
+  static void drawGlyph(Adafruit_GFX* gfx, const uint8_t* bitmaps,
+    const GFXglyph* glyph, int16_t x, int16_t y, uint8_t sx, uint8_t sy,
+    uint16_t color);
+
+  /**************************************************************************/
+  // Same as drawGlyph() but for a glyph whose bitmap is in GFX_TT_BITMAP_RLE
+  // format. Each span is drawn as one rectangle covering all the rows that
+  // repeat it.
+  /**************************************************************************/
+  static void drawGlyphRLE(Adafruit_GFX* gfx, const uint8_t* bitmaps,
+    const GFXglyph* glyph, int16_t x, int16_t y, uint8_t sx, uint8_t sy,
+    uint16_t color);
+
+  // Blend table saved by blendLUT(), for levels 0..(_lutLevels-1).
+  static uint16_t _lut[16];
+  static uint16_t _lutColor;
+  static uint16_t _lutBg;
+  static uint8_t _lutLevels;  // 0 if _lut is not set.
+
+  // Row of pixels in which drawTextOpaque() builds the rows of anti-aliased
+  // text, allocated at its first use and enlarged only for a wider
+  // rectangle, so that a label redrawn over and over doesn't allocate and
+  // free heap memory each time.
+  static uint16_t* _pixelRow;
+  static uint16_t _pixelRowBytes;
+
+  /**************************************************************************/
+  // Return the number of bits per pixel of an anti-aliased bitmap format, or 0
+  // if bitmapFormat is a 1-bit format.
+  /**************************************************************************/
+  static uint8_t grayBits(uint8_t bitmapFormat) {
+    return (bitmapFormat == GFX_TT_BITMAP_GRAY2 ? 2 :
+      bitmapFormat == GFX_TT_BITMAP_GRAY4 ? 4 : 0);
+  }
+
+  /**************************************************************************/
+  // Return the table of 'levels' colors blending from bg to color, computing
+  // it only if it differs from the table returned by the previous call.
+  /**************************************************************************/
+  static const uint16_t* blendLUT(uint8_t levels, uint16_t color,
+    uint16_t bg);
+
+  /**************************************************************************/
+  // Same as drawGlyph() but for a glyph whose bitmap has 'bpp' bits per pixel.
+  // Runs of pixels with the same coverage level of at least 'minLevel' are
+  // drawn as one span of color lut[level].
+  /**************************************************************************/
+  static void drawGlyphGray(Adafruit_GFX* gfx, const uint8_t* bitmaps,
+    const GFXglyph* glyph, uint8_t bpp, int16_t x, int16_t y, uint8_t sx,
+    uint8_t sy, const uint16_t* lut, uint8_t minLevel);
+
+  /**************************************************************************/
+  // Draw character c with its cursor position at (x,y) and advance (x,y)
+  // past it. The font values, including its magnification, are taken from
+  // 'fp'. Anti-aliased glyphs are blended with bg unless bg equals color.
+  /**************************************************************************/
+  static void drawChar(Adafruit_GFX* gfx, const Font_TT::FontParams &fp,
+    int16_t &x, int16_t &y, uint16_t c, uint16_t color, uint16_t bg);
+
+  /**************************************************************************/
+  // Set the bits of row mask 'mask', which is w bits wide, for the n pixels
+  // starting at pixel x. Pixels outside the mask are ignored.
+  /**************************************************************************/
+  static void setMaskBits(uint8_t* mask, int16_t w, int16_t x, int16_t n);
+
+  /**************************************************************************/
+  // Set the bits of row mask 'mask', which is w bits wide, for the set pixels
+  // of row 'row' of a glyph whose left edge is at mask pixel x, magnified
+  // horizontally by sx.
+  /**************************************************************************/
+  static void maskGlyphRow(uint8_t* mask, int16_t w, const uint8_t* bitmaps,
+    const GFXglyph* glyph, uint8_t bitmapFormat, int16_t x, uint8_t row,
+    uint8_t sx);
+
+  /**************************************************************************/
+  // Draw row mask 'mask', which is w bits wide, at (x,y), drawing set bits
+  // with 'color' and clear bits with 'bg'. If 'windowed' is true, the row is
+  // the next row of the current address window of an Adafruit_SPITFT display.
+  // On a 16-bit strip buffer, the row is expanded into it with expandBits().
+  /**************************************************************************/
+  static void drawMaskRow(Adafruit_GFX* gfx, bool windowed,
+    const uint8_t* mask, int16_t x, int16_t y, int16_t w, uint16_t color,
+    uint16_t bg);
+
+  /**************************************************************************/
+  // Set the pixels of row 'pixels', which is w pixels wide, that are covered
+  // by row 'row' of an anti-aliased glyph with 'bpp' bits per pixel, whose
+  // left edge is at pixel x, magnified horizontally by sx. A pixel with
+  // coverage level L > 0 is set to lut[L].
+  /**************************************************************************/
+  static void grayGlyphRow(uint16_t* pixels, int16_t w,
+    const uint8_t* bitmaps, const GFXglyph* glyph, uint8_t bpp, int16_t x,
+    uint8_t row, uint8_t sx, const uint16_t* lut);
+
+  /**************************************************************************/
+  // Draw the w RGB565 pixels 'pixels' at (x,y), as runs of equal pixels. If
+  // 'windowed' is true, the row is the next row of the current address window
+  // of an Adafruit_SPITFT display. On a strip buffer, the row is copied into
+  // it.
+  /**************************************************************************/
+  static void drawPixelRow(Adafruit_GFX* gfx, bool windowed,
+    uint16_t* pixels, int16_t x, int16_t y, int16_t w);
+
+  /**************************************************************************/
+  // Draw the w x h block of RGB565 pixels 'pixels' at (x,y).
+  /**************************************************************************/
+  static void drawPixelBlock(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    uint16_t* pixels, int16_t w, int16_t h);
+
+  #if GLYPH_CACHE_TT_INDEXED
+  /**************************************************************************/
+  // Draw the w x h block of coverage levels 'levels' at (x,y), expanding each
+  // row to RGB565 pixels through 'lut' in 'pixels', a row of w pixels.
+  /**************************************************************************/
+  static void drawLevelBlock(Adafruit_GFX* gfx, int16_t x, int16_t y,
+    const uint8_t* levels, int16_t w, int16_t h, const uint16_t* lut,
+    uint16_t* pixels);
+  #endif
+
+public:
+
+  /**************************************************************************/
+  /*!
+    @brief    Set the strip renderer whose strip buffer is being drawn on.
+              It is drawn on without address windows even if
+              TEXT_RENDER_TT_SPITFT is 1, and rows of text pixels are
+              written straight into its buffer (see StripRender_TT.h).
+    @param    strips  The strip renderer, nullptr for none.
+  */
+  /**************************************************************************/
+  static void setOffscreen(StripRender_TT* strips) { _offscreen = strips; }
+
+  /**************************************************************************/
+  /*!
+    @brief    Test whether a rectangle can be drawn through an address window
+              of an Adafruit_SPITFT display.
+    @param    gfx     The display object.
+    @param    x       Left edge of the rectangle.
+    @param    y       Top edge of the rectangle.
+    @param    w       Width of the rectangle.
+    @param    h       Height of the rectangle.
+    @returns  true if TEXT_RENDER_TT_SPITFT is 1, gfx is not the off-screen
+              display object, and the rectangle lies on the display and
+              inside the clip rectangle of Clip_TT.
+  */
+  /**************************************************************************/
+  static bool windowable(Adafruit_GFX* gfx, int16_t x, int16_t y, int16_t w,
+    int16_t h);
+
+  /**************************************************************************/
+  /*!
+    @brief    Draw a text string.
+    @param    gfx     The display object to draw on.
+    @param    f       The font object giving the font and its magnification.
+    @param    x       Reference to the cursor x-coordinate, the start of the
+                      text baseline on call, advanced past the text on return.
+    @param    y       Reference to the cursor y-coordinate, the text baseline.
+                      A newline in str resets x to 0 and advances y.
+    @param    str     The text string, UTF-8 if f->isUTF8() is true.
+    @param    color   The text color.
+  */
+  /**************************************************************************/
+  static void drawText(Adafruit_GFX* gfx, Font_TT* f, int16_t &x, int16_t &y,
+    const char* str, uint16_t color) {
+    drawText(gfx, f, x, y, str, color, color);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Draw a text string over a known background color.
+    @param    gfx     The display object to draw on.
+    @param    f       The font object giving the font and its magnification.
+    @param    x       Reference to the cursor x-coordinate, the start of the
+                      text baseline on call, advanced past the text on return.
+    @param    y       Reference to the cursor y-coordinate, the text baseline.
+                      A newline in str resets x to 0 and advances y.
+    @param    str     The text string, UTF-8 if f->isUTF8() is true.
+    @param    color   The text color.
+    @param    bg      The color the text is drawn over. The edge pixels of
+                      anti-aliased fonts are blended with it, unless it equals
+                      'color'. No background pixels are drawn.
+  */
+  /**************************************************************************/
+  static void drawText(Adafruit_GFX* gfx, Font_TT* f, int16_t &x, int16_t &y,
+    const char* str, uint16_t color, uint16_t bg);
+
+  /**************************************************************************/
+  /*!
+    @brief    Draw a single character.
+    @param    gfx     The display object to draw on.
+    @param    f       The font object giving the font and its magnification.
+    @param    x       Reference to the cursor x-coordinate, advanced past the
+                      character on return.
+    @param    y       Reference to the cursor y-coordinate, the text baseline.
+    @param    c       The character code, or Unicode code point if
+                      f->isUTF8() is true.
+    @param    color   The text color.
+  */
+  /**************************************************************************/
+  static void drawChar(Adafruit_GFX* gfx, Font_TT* f, int16_t &x, int16_t &y,
+    uint16_t c, uint16_t color) {
+    drawChar(gfx, f, x, y, c, color, color);
+  }
+
+  /**************************************************************************/
+  /*!
+    @brief    Draw a single character over a known background color.
+    @param    gfx     The display object to draw on.
+    @param    f       The font object giving the font and its magnification.
+    @param    x       Reference to the cursor x-coordinate, advanced past the
+                      character on return.
+    @param    y       Reference to the cursor y-coordinate, the text baseline.
+    @param    c       The character code, or Unicode code point if
+                      f->isUTF8() is true.
+    @param    color   The text color.
+    @param    bg      The color the character is drawn over, see drawText().
+  */
+  /**************************************************************************/
+  static void drawChar(Adafruit_GFX* gfx, Font_TT* f, int16_t &x, int16_t &y,
+    uint16_t c, uint16_t color, uint16_t bg);
+
+  /**************************************************************************/
+  /*!
+    @brief    Draw a text string with an opaque background, filling the
+              rectangle (xL, yT, w, h) containing it in a single pass.
+    @param    gfx     The display object to draw on.
+    @param    f       The font object giving the font and its magnification.
+    @param    x       Reference to the cursor x-coordinate, the start of the
+                      text baseline on call, advanced past the text on return.
+    @param    y       Reference to the cursor y-coordinate, the text baseline.
+    @param    str     The text string, UTF-8 if f->isUTF8() is true.
+    @param    color   The text color.
+    @param    bg      The background color.
+    @param    xL      Left x-coordinate of the rectangle to fill.
+    @param    yT      Top y-coordinate of the rectangle to fill.
+    @param    w       Width of the rectangle.
+    @param    h       Height of the rectangle.
+    @note     Text outside the rectangle is not drawn. The built-in font is
+              drawn by filling the rectangle and then drawing the text.
+  */
+  /**************************************************************************/
+  static void drawTextOpaque(Adafruit_GFX* gfx, Font_TT* f, int16_t &x,
+    int16_t &y, const char* str, uint16_t color, uint16_t bg, int16_t xL,
+    int16_t yT, int16_t w, int16_t h);
+
+  /**************************************************************************/
+  /*!
+    @brief    Draw a text string with an opaque background, filling each
+              character's cell, using a cache of pre-expanded character cells.
+    @param    gfx     The display object to draw on.
+    @param    f       The font object giving the font and its magnification.
+    @param    cache   The glyph cache to use.
+    @param    x       Reference to the cursor x-coordinate, the start of the
+                      text baseline on call, advanced past the text on return.
+    @param    y       Reference to the cursor y-coordinate, the text baseline.
+    @param    str     The text string, UTF-8 if f->isUTF8() is true.
+    @param    color   The text color.
+    @param    bg      The background color.
+    @note     A character cell is the character's advance width wide and the
+              font's full height high, as given by Font_TT::getFontExtent().
+              Any part of a glyph extending outside its cell is not drawn.
+  */
+  /**************************************************************************/
+  static void drawTextCached(Adafruit_GFX* gfx, Font_TT* f,
+    GlyphCache_TT* cache, int16_t &x, int16_t &y, const char* str,
+    uint16_t color, uint16_t bg);
+
+  /**************************************************************************/
+  /*!
+    @brief    Expand a row of 1-bit pixels (such as a glyph or icon mask row)
+              into RGB565 pixels.
+    @param    bits    The 1-bit pixels, in RAM, 8 per byte, most significant
+                      bit first.
+    @param    pixels  Array to receive the w RGB565 pixels.
+    @param    w       Number of pixels.
+    @param    color   Pixel value for 1 bits.
+    @param    bg      Pixel value for 0 bits.
+    @note     This uses SSE2 or AVX2 instructions on x86 processors and NEON
+              instructions on ARM processors that have them, expanding 8 or 16
+              pixels per step, and otherwise a table of pixel pairs.
+  */
+  /**************************************************************************/
+  static void expandBits(const uint8_t* bits, uint16_t* pixels, int16_t w,
+    uint16_t color, uint16_t bg);
+
+  /**************************************************************************/
+  /*!
+    @brief    Compute a table of colors blending from one RGB565 color to
+              another, for drawing anti-aliased pixels by table lookup.
+    @param    lut     Array to receive the n colors, lut[0] = bg and
+                      lut[n-1] = color.
+    @param    n       Number of colors, 2 to 16.
+    @param    color   The color of a fully covered pixel.
+    @param    bg      The color of an uncovered pixel.
+  */
+  /**************************************************************************/
+  static void makeBlendLUT(uint16_t* lut, uint8_t n, uint16_t color,
+    uint16_t bg);
+};
+
+#endif // TextRender_TT_h
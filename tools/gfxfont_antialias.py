@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+gfxfont_antialias.py - Create an anti-aliased GFXfont_TT font, with 2 or 4
+bit-per-pixel glyph bitmaps (GFX_TT_BITMAP_GRAY2 or GFX_TT_BITMAP_GRAY4), by
+reducing a larger Adafruit_GFX GFXfont (or GFXfont_TT font), for use with
+Font_TT and TextRender_TT.
+
+Released into the public domain.
+
+Usage:
+  gfxfont_antialias.py FreeSans36pt7b.h Sans9pt_AA.h -r 4 [-b 2|4] [-n NAME]
+
+  -r N          Reduction factor: each N x N block of the input font's pixels
+                becomes one pixel of the output font, whose coverage level is
+                the fraction of the block's pixels that are set. Use an input
+                font N times the point size wanted, e.g. FreeSans36pt7b with
+                '-r 4' gives a 9 point font.
+  -b 2|4        Bits per pixel of the output, default 4 (16 levels). 2 bits
+                (4 levels) takes half the flash and still looks much smoother
+                than a 1-bit font.
+  -n NAME       Name of the output font, default the input font name with
+                "_AA" appended.
+
+Glyph metrics are the input metrics divided by N, with each glyph bitmap
+widened to whole output pixels, and xAdvance and yAdvance rounded to the
+nearest pixel, so the output measures like a font of the smaller size.
+"""
+
+import argparse
+import sys
+import gfxfont_tt
+
+
+def _ceil_div(a, n):
+    return -((-a) // n)
+
+
+def reduce_glyph(g, n, levels):
+    """Return glyph g reduced n times, with coverage levels 0..levels-1."""
+    # The output pixel grid is aligned with the glyph's cursor position, so
+    # that glyphs drawn next to each other line up.
+    x0 = g.xOffset // n
+    y0 = g.yOffset // n
+    x1 = _ceil_div(g.xOffset + g.width, n)
+    y1 = _ceil_div(g.yOffset + g.height, n)
+    if g.width == 0 or g.height == 0:
+        x1, y1 = x0, y0
+    rows = []
+    top = levels - 1
+    for Y in range(y0, y1):
+        row = []
+        for X in range(x0, x1):
+            count = 0
+            for y in range(Y * n - g.yOffset, (Y + 1) * n - g.yOffset):
+                if 0 <= y < g.height:
+                    src = g.rows[y]
+                    for x in range(X * n - g.xOffset, (X + 1) * n - g.xOffset):
+                        if 0 <= x < g.width:
+                            count += src[x]
+            row.append((count * top + n * n // 2) // (n * n))
+        rows.append(row)
+    return gfxfont_tt.Glyph(g.code, x1 - x0, y1 - y0,
+                            (g.xAdvance + n // 2) // n, x0, y0, rows)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("input", help="GFXfont or GFXfont_TT header file")
+    ap.add_argument("output", help="output GFXfont_TT header file")
+    ap.add_argument("-r", "--reduce", type=int, required=True,
+                    help="reduction factor")
+    ap.add_argument("-b", "--bits", type=int, choices=(2, 4), default=4,
+                    help="bits per pixel of the output")
+    ap.add_argument("-n", "--name", help="name of the output font")
+    args = ap.parse_args()
+
+    font = gfxfont_tt.read_font(args.input)
+    if font.format.startswith("gray"):
+        sys.exit("gfxfont_antialias.py: the input font is already anti-aliased")
+    if args.reduce < 1:
+        sys.exit("gfxfont_antialias.py: the reduction factor must be at least 1")
+    fmt = "gray%d" % args.bits
+    name = args.name or font.name + "_AA"
+    glyphs = [reduce_glyph(g, args.reduce, 1 << args.bits) for g in font.glyphs]
+    out = gfxfont_tt.Font(name, (font.yAdvance + args.reduce // 2) // args.reduce,
+                          glyphs, fmt)
+    with open(args.output, "w") as f:
+        f.write(gfxfont_tt.write_font(out, name, fmt))
+    sys.stderr.write("%s: %d glyphs, %d bytes\n" % (
+        name, len(glyphs), gfxfont_tt.flash_size(out, fmt)))
+
+
+if __name__ == "__main__":
+    main()
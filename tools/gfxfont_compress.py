@@ -0,0 +1,41 @@
+#!/usr/bin/env python3
+"""
+gfxfont_compress.py - Convert an Adafruit_GFX GFXfont header file (or a
+GFXfont_TT header file) into a GFXfont_TT font whose glyph bitmaps are row
+run-length encoded (GFX_TT_BITMAP_RLE), for use with Font_TT and TextRender_TT.
+
+Released into the public domain.
+
+Usage:
+  gfxfont_compress.py FreeSansBold24pt7b.h FreeSansBold24pt7b_RLE.h [-n NAME]
+
+Large fonts, particularly digits used for numeric readouts, compress to a
+fraction of their raw size, since vertical strokes become a single record for
+many rows. Small fonts may not compress; the tool reports both sizes so you
+can decide.
+"""
+
+import argparse
+import sys
+import gfxfont_tt
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("input", help="GFXfont or GFXfont_TT header file")
+    ap.add_argument("output", help="output GFXfont_TT header file")
+    ap.add_argument("-n", "--name", help="name of the output font")
+    args = ap.parse_args()
+
+    font = gfxfont_tt.read_font(args.input)
+    name = args.name or font.name + "_RLE"
+    raw = gfxfont_tt.flash_size(font, "raw")
+    rle = gfxfont_tt.flash_size(font, "rle")
+    with open(args.output, "w") as f:
+        f.write(gfxfont_tt.write_font(font, name, "rle"))
+    sys.stderr.write("%s: raw %d bytes, rle %d bytes (%d%%)\n" % (
+        name, raw, rle, 100 * rle // max(raw, 1)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+gfxfont_scale.py - Add pre-scaled variants to an Adafruit_GFX GFXfont (or a
+GFXfont_TT font), written as a GFXfont_TT font whose 'scaled' table lists the
+variants, for use with Font_TT and TextRender_TT.
+
+Released into the public domain.
+
+Usage:
+  gfxfont_scale.py Digits24.h Digits24_scaled.h -s 2 [-s 3 ...] [--smooth] \\
+      [-f FORMAT] [-n NAME]
+
+Text drawn with a Font_TT text size above 1 normally magnifies each font
+pixel into a block of pixels as it is drawn. This works, but it looks blocky
+and draws each block separately. A pre-scaled variant is a copy of the font
+whose glyphs were magnified by this tool, so text of that size (or a multiple
+of it) draws directly from the variant's bitmaps. All metrics of a variant
+are the original metrics times the magnification, so text measures the same
+whether or not a variant is used.
+
+  -s N          Write a variant magnified N times (may be repeated).
+  --smooth      Smooth the diagonal edges of the variants with the Scale2x and
+                Scale3x pixel-art scaling algorithms, applied repeatedly for
+                magnifications made up of factors of 2 and 3 (any remaining
+                factor is simple pixel replication). Smoothed text no longer
+                exactly matches the magnified original, but its measurements
+                do.
+  -f FORMAT     Bitmap format of the output, default 'rle', which compresses
+                the large glyphs of variants well, or the input's format for
+                an anti-aliased font.
+  -n NAME       Name of the output font, default the input font name.
+
+The output file holds each variant as a font named NAME_xN, the GFXscaled_TT
+table NAMEScaled, and the font NAME itself, which is the one to use.
+
+Glyph metrics of a GFXfont are bytes, so a variant must have glyphs of at
+most 255 pixels wide and high, and offsets of -128 to 127; the tool stops
+with an error if a magnification is too large for the font.
+"""
+
+import argparse
+import sys
+import gfxfont_tt
+
+
+def _pixel(rows, x, y):
+    if 0 <= y < len(rows) and 0 <= x < len(rows[y]):
+        return rows[y][x]
+    return 0
+
+
+def scale_nearest(rows, n):
+    """Magnify a bitmap n times by replicating each pixel."""
+    out = []
+    for row in rows:
+        big = [v for v in row for _ in range(n)]
+        out += [list(big) for _ in range(n)]
+    return out
+
+
+def scale2x(rows):
+    """Magnify a bitmap 2 times with the Scale2x (EPX) algorithm."""
+    out = []
+    for y in range(len(rows)):
+        r0 = []
+        r1 = []
+        for x in range(len(rows[y])):
+            e = rows[y][x]
+            b = _pixel(rows, x, y - 1)
+            d = _pixel(rows, x - 1, y)
+            f = _pixel(rows, x + 1, y)
+            h = _pixel(rows, x, y + 1)
+            if b != h and d != f:
+                r0 += [d if d == b else e, f if b == f else e]
+                r1 += [d if d == h else e, f if h == f else e]
+            else:
+                r0 += [e, e]
+                r1 += [e, e]
+        out += [r0, r1]
+    return out
+
+
+def scale3x(rows):
+    """Magnify a bitmap 3 times with the Scale3x (AdvMAME3x) algorithm."""
+    out = []
+    for y in range(len(rows)):
+        r0 = []
+        r1 = []
+        r2 = []
+        for x in range(len(rows[y])):
+            a = _pixel(rows, x - 1, y - 1)
+            b = _pixel(rows, x, y - 1)
+            c = _pixel(rows, x + 1, y - 1)
+            d = _pixel(rows, x - 1, y)
+            e = rows[y][x]
+            f = _pixel(rows, x + 1, y)
+            g = _pixel(rows, x - 1, y + 1)
+            h = _pixel(rows, x, y + 1)
+            i = _pixel(rows, x + 1, y + 1)
+            if b != h and d != f:
+                r0 += [d if d == b else e,
+                       b if (d == b and e != c) or (b == f and e != a) else e,
+                       f if b == f else e]
+                r1 += [d if (d == b and e != g) or (d == h and e != a) else e,
+                       e,
+                       f if (b == f and e != i) or (h == f and e != c) else e]
+                r2 += [d if d == h else e,
+                       h if (d == h and e != i) or (h == f and e != g) else e,
+                       f if h == f else e]
+            else:
+                r0 += [e, e, e]
+                r1 += [e, e, e]
+                r2 += [e, e, e]
+        out += [r0, r1, r2]
+    return out
+
+
+def scale_rows(rows, n, smooth):
+    """Magnify a bitmap n times, smoothing it if smooth is true."""
+    if smooth:
+        while n % 3 == 0:
+            rows = scale3x(rows)
+            n //= 3
+        while n % 2 == 0:
+            rows = scale2x(rows)
+            n //= 2
+    if n > 1:
+        rows = scale_nearest(rows, n)
+    return rows
+
+
+def scale_font(font, n, smooth):
+    """Return a copy of font magnified n times."""
+    glyphs = []
+    for g in font.glyphs:
+        sg = gfxfont_tt.Glyph(g.code, g.width * n, g.height * n,
+                              g.xAdvance * n, g.xOffset * n, g.yOffset * n,
+                              scale_rows(g.rows, n, smooth) if g.width else
+                              [[] for _ in range(g.height * n)])
+        if sg.width > 255 or sg.height > 255 or sg.xAdvance > 255 or \
+                not -128 <= sg.xOffset <= 127 or not -128 <= sg.yOffset <= 127:
+            raise ValueError("glyph U+%04X is too large when magnified %d times"
+                             % (g.code, n))
+        glyphs.append(sg)
+    if font.yAdvance * n > 255:
+        raise ValueError("yAdvance is too large when magnified %d times" % n)
+    return gfxfont_tt.Font(font.name, font.yAdvance * n, glyphs, font.format)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("input", help="GFXfont or GFXfont_TT header file")
+    ap.add_argument("output", help="output GFXfont_TT header file")
+    ap.add_argument("-s", "--scale", type=int, action="append", required=True,
+                    help="magnification of a variant")
+    ap.add_argument("--smooth", action="store_true",
+                    help="smooth the variants with Scale2x/Scale3x")
+    ap.add_argument("-f", "--format", choices=sorted(gfxfont_tt.BITMAP_FORMATS),
+                    help="bitmap format of the output")
+    ap.add_argument("-n", "--name", help="name of the output font")
+    args = ap.parse_args()
+
+    font = gfxfont_tt.read_font(args.input)
+    fmt = args.format or (font.format if font.format.startswith("gray")
+                          else "rle")
+    name = args.name or font.name
+    scales = sorted(set(n for n in args.scale if n > 1))
+    if not scales:
+        sys.exit("gfxfont_scale.py: no magnification greater than 1 given")
+
+    out = []
+    out.append("// %s: %d glyphs with pre-scaled variants x%s, %s format.\n" % (
+        name, len(font.glyphs), ", x".join(str(n) for n in scales),
+        gfxfont_tt.FORMAT_NAMES[gfxfont_tt.BITMAP_FORMATS[fmt]]))
+    out.append("// Generated by a Button_TT font tool, use with Font_TT.\n\n")
+    out.append("#include <GFXfont_TT.h>\n\n")
+    total = 0
+    for n in scales:
+        try:
+            variant = scale_font(font, n, args.smooth)
+            text, _ = gfxfont_tt.write_font_tables(variant, "%s_x%d" % (name, n),
+                                                   fmt)
+        except ValueError as e:
+            sys.exit("gfxfont_scale.py: %s" % e)
+        size = gfxfont_tt.flash_size(variant, fmt)
+        sys.stderr.write("%s_x%d: %d bytes\n" % (name, n, size))
+        total += size
+        out.append(text)
+    out.append("const GFXscaled_TT %sScaled[] PROGMEM = {\n%s\n};\n\n" % (
+        name, ",\n".join("  {%d, %d, &%s_x%d}" % (n, n, name, n)
+                         for n in scales)))
+    text, _ = gfxfont_tt.write_font_tables(font, name, fmt,
+                                           name + "Scaled", len(scales))
+    out.append(text)
+    size = gfxfont_tt.flash_size(font, fmt)
+    total += size + 6 * len(scales)
+    sys.stderr.write("%s: %d bytes, %d bytes with variants\n" % (
+        name, size, total))
+    out.append("// Approximate size in bytes: %d\n" % total)
+    with open(args.output, "w") as f:
+        f.write("".join(out))
+
+
+if __name__ == "__main__":
+    main()
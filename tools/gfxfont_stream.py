@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+gfxfont_stream.py - Convert an Adafruit_GFX GFXfont header file (or a
+GFXfont_TT header file) into a font file for StreamFont_TT, which reads fonts
+from external storage (SPI flash, an SD card, etc.) instead of program flash.
+
+Released into the public domain.
+
+Usage:
+  gfxfont_stream.py FreeSans12pt7b.h Sans12.gft [-f FORMAT]
+
+  -f FORMAT     Bitmap format of the font file, default 'rle' for a 1-bit
+                font, or the input's format for an anti-aliased font.
+
+Copy the font file to the storage and read it with a StreamFont_TT object.
+See src/StreamFont_TT.h for a description of the file format.
+"""
+
+import argparse
+import struct
+import sys
+import gfxfont_tt
+
+HEADER_SIZE = 28
+RANGE_SIZE = 6
+GLYPH_SIZE = 12
+
+
+def write_stream_font(font, fmt_name):
+    """Return the bytes of a StreamFont_TT font file for font."""
+    fmt = gfxfont_tt.BITMAP_FORMATS[fmt_name]
+    if font.format in ("gray2", "gray4") and fmt not in gfxfont_tt.GRAY_BITS:
+        raise ValueError("an anti-aliased font must be written in a gray format")
+    if len(font.glyphs) > 0xFFFF:
+        raise ValueError("the font has more than 65535 glyphs")
+    ranges = gfxfont_tt.ranges_of(font.glyphs)
+    bitmap = bytearray()
+    glyphs = bytearray()
+    top = bottom = 0
+    for g in font.glyphs:
+        data = bytes(gfxfont_tt.encode(g, fmt)) if g.width and g.height else b""
+        if len(data) > 0xFFFF:
+            raise ValueError("glyph U+%04X bitmap exceeds 64K bytes" % g.code)
+        glyphs += struct.pack("<IHBBBbbB", len(bitmap), len(data), g.width,
+                              g.height, g.xAdvance, g.xOffset, g.yOffset, 0)
+        bitmap += data
+        if g.height:
+            top = min(top, g.yOffset)
+            bottom = max(bottom, g.yOffset + g.height)
+    ranges_offset = HEADER_SIZE
+    glyphs_offset = ranges_offset + RANGE_SIZE * len(ranges)
+    bitmaps_offset = glyphs_offset + len(glyphs)
+    header = struct.pack("<4sBBBBHHhhIII", b"GFTT", 1, fmt, font.yAdvance, 0,
+                         len(ranges), len(font.glyphs), top, bottom,
+                         ranges_offset, glyphs_offset, bitmaps_offset)
+    out = bytearray(header)
+    for r in ranges:
+        out += struct.pack("<HHH", *r)
+    return bytes(out + glyphs + bitmap)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("input", help="GFXfont or GFXfont_TT header file")
+    ap.add_argument("output", help="output font file")
+    ap.add_argument("-f", "--format", choices=sorted(gfxfont_tt.BITMAP_FORMATS),
+                    help="bitmap format of the output")
+    args = ap.parse_args()
+
+    font = gfxfont_tt.read_font(args.input)
+    fmt = args.format or (font.format if font.format.startswith("gray")
+                          else "rle")
+    try:
+        data = write_stream_font(font, fmt)
+    except ValueError as e:
+        sys.exit("gfxfont_stream.py: %s" % e)
+    with open(args.output, "wb") as f:
+        f.write(data)
+    sys.stderr.write("%s: %d glyphs, %d bytes\n" % (
+        font.name, len(font.glyphs), len(data)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+gfxfont_subset.py - Create a subset of an Adafruit_GFX GFXfont (or a
+GFXfont_TT font) containing only the characters that a program actually
+draws, written as a GFXfont_TT font for use with Font_TT and TextRender_TT.
+
+Released into the public domain.
+
+Usage:
+  gfxfont_subset.py FreeSans24pt7b.h Readout24.h -n Readout24 \\
+      [-m screens.manifest] [-s sketch.ino ...] [-c CHARS] [-f FORMAT]
+
+The set of characters to keep is the union of:
+
+  -c CHARS      The characters in CHARS (UTF-8).
+  -s FILE ...   Every character of every string literal in the given source
+                files (a safe superset of the labels the program draws), plus
+                digits, '+' and '-' if the file uses a Button_TT_int8/int16
+                numeric button, and digits if it uses a Button_TT_uint8/uint16
+                button. Degree symbols enabled by a degreeSym argument are not
+                detected, use '-m' with a 'degree' entry or '-c' for them.
+  -m MANIFEST   A manifest file listing exactly what a font is used for, one
+                entry per line ('#' starts a comment):
+                  label TEXT            A Button_TT_label label (rest of line).
+                  int MIN MAX [plus]    A signed numeric button value range,
+                                        'plus' if showPlus is true.
+                  uint MIN MAX [ZERO]   An unsigned numeric button value range,
+                                        ZERO is its zeroString if any.
+                  degree                Labels have a degree symbol.
+                  chars TEXT            Additional characters.
+
+Glyphs of the kept characters are written with a GFXrange_TT table mapping
+their code points to the compacted glyph array, so the subset font measures
+and draws exactly like the original for those characters. A kept character
+with no glyph in the font is reported and skipped. If the degree sign is
+needed but the font has no glyph for it, nothing is added, and Button_TT_label
+draws its degree symbol circle as usual.
+"""
+
+import argparse
+import re
+import sys
+import gfxfont_tt
+
+DEGREE_SIGN = 0xB0
+
+
+def _c_string(body):
+    """Decode the body of a C string literal into a str."""
+    out = bytearray()
+    i = 0
+    raw = body.encode("utf-8")
+    while i < len(raw):
+        c = raw[i]
+        if c != ord("\\"):
+            out.append(c)
+            i += 1
+            continue
+        i += 1
+        e = chr(raw[i])
+        if e == "x":
+            m = re.match(rb"[0-9a-fA-F]{1,2}", raw[i + 1:])
+            out.append(int(m.group(0), 16))
+            i += 1 + len(m.group(0))
+        elif e in "01234567":
+            m = re.match(rb"[0-7]{1,3}", raw[i:])
+            out.append(int(m.group(0), 8) & 0xFF)
+            i += len(m.group(0))
+        else:
+            out.append({"n": 10, "r": 13, "t": 9}.get(e, ord(e)))
+            i += 1
+    return out.decode("utf-8", errors="replace")
+
+
+def value_chars(lo, hi, plus=False):
+    """Return the characters needed to print every integer in lo..hi."""
+    chars = set()
+    if lo < 0:
+        chars.add("-")
+    if plus and hi > 0:
+        chars.add("+")
+    if hi - lo > 100000:
+        return chars | set("0123456789")
+    for v in range(lo, hi + 1):
+        chars |= set(str(abs(v)))
+        if len(chars & set("0123456789")) == 10:
+            break
+    return chars
+
+
+def scan_source(path):
+    text = open(path, encoding="utf-8", errors="replace").read()
+    code = re.sub(r"//[^\n]*|/\*.*?\*/", "", text, flags=re.S)
+    chars = set()
+    for m in re.finditer(r'"((?:[^"\\\n]|\\.)*)"', code):
+        chars |= set(_c_string(m.group(1)))
+    if re.search(r"Button_TT_int(8|16)\b", code):
+        chars |= set("0123456789+-")
+    if re.search(r"Button_TT_uint(8|16)\b", code):
+        chars |= set("0123456789")
+    return chars
+
+
+def read_manifest(path):
+    chars = set()
+    for n, line in enumerate(open(path, encoding="utf-8"), 1):
+        line = line.split("#", 1)[0].rstrip("\n")
+        words = line.split()
+        if not words:
+            continue
+        kind = words[0]
+        rest = line.strip()[len(kind):].strip()
+        if kind in ("label", "chars"):
+            chars |= set(rest)
+        elif kind == "int":
+            chars |= value_chars(int(words[1]), int(words[2]),
+                                 len(words) > 3 and words[3] == "plus")
+        elif kind == "uint":
+            chars |= value_chars(int(words[1]), int(words[2]))
+            if len(words) > 3:
+                chars |= set(" ".join(words[3:]).strip('"'))
+        elif kind == "degree":
+            chars.add(chr(DEGREE_SIGN))
+        else:
+            raise SystemExit("%s:%d: unknown entry '%s'" % (path, n, kind))
+    return chars
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("input", help="GFXfont or GFXfont_TT header file")
+    ap.add_argument("output", help="output GFXfont_TT header file")
+    ap.add_argument("-n", "--name", help="name of the output font")
+    ap.add_argument("-c", "--chars", default="", help="characters to keep")
+    ap.add_argument("-s", "--scan", nargs="*", default=[],
+                    help="source files whose strings and buttons are scanned")
+    ap.add_argument("-m", "--manifest", action="append", default=[],
+                    help="manifest file of labels and value ranges")
+    ap.add_argument("-f", "--format", choices=sorted(gfxfont_tt.BITMAP_FORMATS),
+                    help="output bitmap format, default raw, or the input's "
+                    "format for an anti-aliased font")
+    args = ap.parse_args()
+
+    chars = set(args.chars)
+    for path in args.scan:
+        chars |= scan_source(path)
+    for path in args.manifest:
+        chars |= read_manifest(path)
+    chars -= set("\n\r")
+    if not chars:
+        raise SystemExit("no characters selected, use -c, -s, or -m")
+
+    font = gfxfont_tt.read_font(args.input)
+    fmt = args.format or (font.format if font.format.startswith("gray")
+                          else "raw")
+    before = gfxfont_tt.flash_size(font, font.format)
+    codes = sorted(ord(c) for c in chars)
+    missing = [c for c in codes if font.glyph(c) is None]
+    if missing:
+        sys.stderr.write("Not in font, skipped: %s\n" % " ".join(
+            "U+%04X" % c for c in missing))
+    font.glyphs = [g for g in font.glyphs if g.code in codes]
+
+    name = args.name or font.name + "_subset"
+    with open(args.output, "w") as f:
+        f.write(gfxfont_tt.write_font(font, name, fmt))
+    after = gfxfont_tt.flash_size(font, fmt)
+    sys.stderr.write("%s: %d glyphs, %d bytes (was %d bytes)\n" % (
+        name, len(font.glyphs), after, before))
+
+
+if __name__ == "__main__":
+    main()
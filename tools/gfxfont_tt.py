@@ -0,0 +1,372 @@
+"""
+gfxfont_tt.py - Read and write Adafruit_GFX GFXfont and Button_TT GFXfont_TT
+font header files. Used by the other Button_TT font tools in this folder.
+
+Released into the public domain.
+
+A font is read into a Font object holding a list of Glyph objects, each with
+its Unicode code point, metrics, and bitmap as a list of rows of pixels,
+regardless of the bitmap format in the file. Pixels are 0/1, or coverage
+levels 0..3 or 0..15 for anti-aliased fonts. A Font object can be written in
+any of the formats supported by the Button_TT library:
+
+  raw   Standard GFXfont 1 bit-per-pixel bitmaps (GFX_TT_BITMAP_RAW).
+  rle   Row run-length encoded bitmaps (GFX_TT_BITMAP_RLE).
+  gray2 Anti-aliased 2 bit-per-pixel bitmaps (GFX_TT_BITMAP_GRAY2).
+  gray4 Anti-aliased 4 bit-per-pixel bitmaps (GFX_TT_BITMAP_GRAY4).
+
+See src/GFXfont_TT.h for a description of the formats.
+"""
+
+import re
+
+BITMAP_FORMATS = {"raw": 0, "rle": 1, "gray2": 2, "gray4": 3}
+FORMAT_NAMES = {0: "GFX_TT_BITMAP_RAW", 1: "GFX_TT_BITMAP_RLE",
+                2: "GFX_TT_BITMAP_GRAY2", 3: "GFX_TT_BITMAP_GRAY4"}
+GRAY_BITS = {2: 2, 3: 4}
+RLE_REPEAT = 0x80
+RLE_MAX_REPEAT = 0xFF - RLE_REPEAT + 1
+
+
+class Glyph:
+    """One glyph: code point, metrics, and bitmap rows of 0/1 pixels."""
+
+    def __init__(self, code, width, height, xAdvance, xOffset, yOffset, rows):
+        self.code = code
+        self.width = width
+        self.height = height
+        self.xAdvance = xAdvance
+        self.xOffset = xOffset
+        self.yOffset = yOffset
+        self.rows = rows
+
+
+class Font:
+    """A font: its name, yAdvance, glyphs sorted by code point, and the name
+    of the bitmap format it was read in."""
+
+    def __init__(self, name, yAdvance, glyphs, format="raw"):
+        self.name = name
+        self.yAdvance = yAdvance
+        self.glyphs = sorted(glyphs, key=lambda g: g.code)
+        self.format = format
+
+    def glyph(self, code):
+        for g in self.glyphs:
+            if g.code == code:
+                return g
+        return None
+
+
+# ---------------------------------------------------------------------------
+# Reading.
+# ---------------------------------------------------------------------------
+
+def _strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def _numbers(body):
+    body = re.sub(r"\(\s*[\w\s]+\*\s*\)", "", body)  # Drop pointer casts.
+    return [int(t, 0) for t in re.findall(r"-?(?:0[xX][0-9a-fA-F]+|\d+)", body)]
+
+
+def _struct(text, ctype, name=None, last=False):
+    """Return (name, body) of a struct definition: the one with the given
+    name, else the first one (or last one if last is true)."""
+    ms = list(re.finditer(r"const\s+" + ctype + r"\s+(\w+)\s*(?:PROGMEM)?\s*=\s*\{(.*?)\}\s*;",
+                          text, flags=re.S))
+    if name is not None:
+        ms = [m for m in ms if m.group(1) == name]
+    if not ms:
+        return None, None
+    m = ms[-1] if last else ms[0]
+    return m.group(1), m.group(2)
+
+
+def _named_array(text, ctype, name):
+    m = re.search(r"const\s+" + ctype + r"\s+" + name + r"\s*\[\s*\]\s*(?:PROGMEM)?\s*=\s*\{(.*?)\}\s*;",
+                  text, flags=re.S)
+    return m.group(1) if m else None
+
+
+def _identifiers(body):
+    return re.findall(r"[A-Za-z_]\w*", re.sub(r"\(\s*[\w\s]+\*\s*\)", "", body))
+
+
+def _raw_rows(bitmap, offset, w, h):
+    rows = []
+    bit = offset * 8
+    for _ in range(h):
+        row = []
+        for _ in range(w):
+            row.append((bitmap[bit >> 3] >> (7 - (bit & 7))) & 1)
+            bit += 1
+        rows.append(row)
+    return rows
+
+
+def _gray_rows(bitmap, offset, w, h, bpp):
+    rows = []
+    bit = offset * 8
+    for _ in range(h):
+        row = []
+        for _ in range(w):
+            row.append((bitmap[bit >> 3] >> (8 - bpp - (bit & 7))) & ((1 << bpp) - 1))
+            bit += bpp
+        rows.append(row)
+    return rows
+
+
+def _rle_rows(bitmap, offset, w, h):
+    rows = []
+    p = offset
+    while len(rows) < h:
+        n = bitmap[p]
+        p += 1
+        if n & RLE_REPEAT:
+            rows += [list(rows[-1]) for _ in range(n - RLE_REPEAT + 1)]
+            continue
+        row = [0] * w
+        x = 0
+        for _ in range(n):
+            x += bitmap[p]
+            length = bitmap[p + 1]
+            p += 2
+            for i in range(length):
+                row[x + i] = 1
+            x += length
+        rows.append(row)
+    return rows
+
+
+def read_font(path):
+    """Read a GFXfont or GFXfont_TT header file and return a Font."""
+    text = _strip_comments(open(path).read())
+
+    # A file written by gfxfont_scale.py holds several fonts. The one to read
+    # is the last GFXfont_TT, and its GFXfont, bitmaps, glyphs, and ranges are
+    # found by name.
+    tt_name, tt_body = _struct(text, "GFXfont_TT", last=True)
+    tt_ids = _identifiers(tt_body) if tt_body is not None else []
+    font_name, font_body = _struct(text, "GFXfont",
+                                   name=tt_ids[0] if tt_ids else None)
+    bitmap_body = glyph_body = None
+    if font_body is not None:
+        ids = _identifiers(font_body)
+        if len(ids) >= 2:
+            bitmap_body = _named_array(text, "uint8_t", ids[0])
+            glyph_body = _named_array(text, "GFXglyph", ids[1])
+    if bitmap_body is None or glyph_body is None or font_body is None:
+        raise ValueError("%s: no GFXfont found" % path)
+    bitmap = _numbers(bitmap_body)
+    gnums = _numbers(glyph_body)
+    entries = [gnums[i:i + 6] for i in range(0, len(gnums), 6)]
+    fnums = _numbers(font_body)
+    first, last, yAdvance = fnums[-3], fnums[-2], fnums[-1]
+
+    # Map glyph array index to code point, using the range table if present.
+    name = font_name
+    fmt = 0
+    codes = [first + i for i in range(len(entries))]
+    if tt_body is not None:
+        name = tt_name
+        fields = [t.strip() for t in tt_body.split(",")]
+        if len(fields) >= 4:
+            f = fields[3]
+            if f in FORMAT_NAMES.values():
+                fmt = [k for k, v in FORMAT_NAMES.items() if v == f][0]
+            else:
+                fmt = int(f, 0)
+        range_body = None
+        if len(tt_ids) >= 2 and tt_ids[1] != "nullptr":
+            range_body = _named_array(text, "GFXrange_TT", tt_ids[1])
+        if range_body is not None:
+            rnums = _numbers(range_body)
+            codes = [None] * len(entries)
+            for i in range(0, len(rnums), 3):
+                rf, rl, gi = rnums[i:i + 3]
+                for c in range(rf, rl + 1):
+                    codes[gi + c - rf] = c
+
+    glyphs = []
+    for code, (off, w, h, xa, xo, yo) in zip(codes, entries):
+        if code is None:
+            continue
+        if fmt == 1:
+            rows = _rle_rows(bitmap, off, w, h)
+        elif fmt in GRAY_BITS:
+            rows = _gray_rows(bitmap, off, w, h, GRAY_BITS[fmt])
+        else:
+            rows = _raw_rows(bitmap, off, w, h)
+        glyphs.append(Glyph(code, w, h, xa, xo, yo, rows))
+    fmt_name = [k for k, v in BITMAP_FORMATS.items() if v == fmt][0]
+    return Font(name, yAdvance, glyphs, fmt_name)
+
+
+# ---------------------------------------------------------------------------
+# Writing.
+# ---------------------------------------------------------------------------
+
+def encode_raw(g):
+    """Encode a glyph bitmap in GFXfont format."""
+    out = []
+    acc = 0
+    nbits = 0
+    for row in g.rows:
+        for v in row:
+            acc = (acc << 1) | v
+            nbits += 1
+            if nbits == 8:
+                out.append(acc)
+                acc = nbits = 0
+    if nbits:
+        out.append(acc << (8 - nbits))
+    return out
+
+
+def _row_spans(row):
+    spans = []
+    x = 0
+    end = 0
+    while x < len(row):
+        if row[x]:
+            start = x
+            while x < len(row) and row[x]:
+                x += 1
+            spans.append((start - end, x - start))
+            end = x
+        else:
+            x += 1
+    return spans
+
+
+def encode_rle(g):
+    """Encode a glyph bitmap in GFX_TT_BITMAP_RLE format."""
+    out = []
+    y = 0
+    while y < g.height:
+        row = g.rows[y]
+        spans = _row_spans(row)
+        out.append(len(spans))
+        for skip, length in spans:
+            out += [skip, length]
+        y += 1
+        while y < g.height and g.rows[y] == row:
+            n = 1
+            while y + n < g.height and g.rows[y + n] == row and n < RLE_MAX_REPEAT:
+                n += 1
+            out.append(RLE_REPEAT + n - 1)
+            y += n
+    return out
+
+
+def encode_gray(g, bpp):
+    """Encode an anti-aliased glyph bitmap with bpp bits per pixel."""
+    out = []
+    acc = 0
+    nbits = 0
+    top = (1 << bpp) - 1
+    for row in g.rows:
+        for v in row:
+            acc = (acc << bpp) | min(v, top)
+            nbits += bpp
+            if nbits == 8:
+                out.append(acc)
+                acc = nbits = 0
+    if nbits:
+        out.append(acc << (8 - nbits))
+    return out
+
+
+def encode(g, fmt):
+    if fmt == 1:
+        return encode_rle(g)
+    if fmt in GRAY_BITS:
+        return encode_gray(g, GRAY_BITS[fmt])
+    return encode_raw(g)
+
+
+def ranges_of(glyphs):
+    """Return (first, last, glyphIndex) ranges of consecutive code points."""
+    ranges = []
+    for i, g in enumerate(glyphs):
+        if ranges and ranges[-1][1] + 1 == g.code:
+            ranges[-1][1] = g.code
+        else:
+            ranges.append([g.code, g.code, i])
+    return ranges
+
+
+def _hex_lines(data, per_line=12):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append("  " + ", ".join("0x%02X" % b for b in data[i:i + per_line]))
+    return ",\n".join(lines)
+
+
+def _char_comment(code):
+    if 0x20 < code < 0x7F and chr(code) not in "\\":
+        return "0x%02X '%s'" % (code, chr(code))
+    return "U+%04X" % code
+
+
+def write_font(font, name, fmt_name="raw"):
+    """Return the text of a GFXfont_TT header file for font."""
+    text, nbitmap = write_font_tables(font, name, fmt_name)
+    out = []
+    out.append("// %s: %d glyphs, %d bitmap bytes, %s format.\n" % (
+        name, len(font.glyphs), nbitmap, FORMAT_NAMES[BITMAP_FORMATS[fmt_name]]))
+    out.append("// Generated by a Button_TT font tool, use with Font_TT.\n\n")
+    out.append("#include <GFXfont_TT.h>\n\n")
+    out.append(text)
+    out.append("// Approximate size in bytes: %d\n" % flash_size(font, fmt_name))
+    return "".join(out)
+
+
+def write_font_tables(font, name, fmt_name="raw", scaled=None, num_scaled=0):
+    """Return (text, bitmap byte count) of the tables of a GFXfont_TT font
+    named name: bitmaps, glyphs, GFXfont, ranges, and the GFXfont_TT itself,
+    which refers to the GFXscaled_TT table named scaled if not None."""
+    fmt = BITMAP_FORMATS[fmt_name]
+    if font.format in ("gray2", "gray4") and fmt not in GRAY_BITS:
+        raise ValueError("%s: an anti-aliased font must be written in a gray "
+                         "format" % name)
+    bitmap = []
+    glyph_lines = []
+    for g in font.glyphs:
+        data = encode(g, fmt) if g.width and g.height else []
+        if len(bitmap) > 0xFFFF:
+            raise ValueError("%s: bitmaps exceed 64K bytes" % name)
+        glyph_lines.append("  {%5d, %3d, %3d, %3d, %4d, %4d}, // %s" % (
+            len(bitmap), g.width, g.height, g.xAdvance, g.xOffset, g.yOffset,
+            _char_comment(g.code)))
+        bitmap += data
+    ranges = ranges_of(font.glyphs)
+    first = font.glyphs[0].code if font.glyphs else 0
+    last = font.glyphs[-1].code if font.glyphs else 0
+    fmt_const = FORMAT_NAMES[fmt]
+
+    out = []
+    out.append("const uint8_t %sBitmaps[] PROGMEM = {\n%s};\n\n" % (
+        name, _hex_lines(bitmap) + "\n" if bitmap else "  0x00\n"))
+    out.append("const GFXglyph %sGlyphs[] PROGMEM = {\n%s\n};\n\n" % (
+        name, "\n".join(glyph_lines)))
+    out.append("const GFXfont %sGFX PROGMEM = {(uint8_t *)%sBitmaps,\n"
+               "  (GFXglyph *)%sGlyphs, 0x%02X, 0x%02X, %d};\n\n" % (
+                   name, name, name, first & 0xFFFF, last & 0xFFFF, font.yAdvance))
+    out.append("const GFXrange_TT %sRanges[] PROGMEM = {\n%s\n};\n\n" % (
+        name, ",\n".join("  {0x%04X, 0x%04X, %d}" % tuple(r) for r in ranges)))
+    extra = ", %s, %d" % (scaled, num_scaled) if scaled else ""
+    out.append("const GFXfont_TT %s PROGMEM = {&%sGFX, %sRanges, %d, %s%s};\n\n" % (
+        name, name, name, len(ranges), fmt_const, extra))
+    return "".join(out), len(bitmap)
+
+
+def flash_size(font, fmt_name="raw"):
+    """Return the approximate flash size in bytes of font written in a format."""
+    fmt = BITMAP_FORMATS[fmt_name]
+    nbytes = sum(len(encode(g, fmt)) for g in font.glyphs
+                 if g.width and g.height)
+    return nbytes + 7 * len(font.glyphs) + 6 * len(ranges_of(font.glyphs))